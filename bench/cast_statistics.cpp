@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+// Measures the cost of counting value_preserving_cast at a cast_site: the time per conversion
+// with and without a cast_site, for a loop that does nothing but convert.
+
+#include <vir/cast_statistics.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  constexpr std::size_t n = 4096;
+  constexpr int repetitions = 2000;
+  constexpr int runs = 25;
+
+  /// Time per element of one run of @p repetitions calls of @p fun.
+  template <typename F>
+    double
+    ns_per_element(F&& fun)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      for (int r = 0; r < repetitions; ++r)
+        fun();
+      const std::chrono::duration<double, std::nano> t = std::chrono::steady_clock::now() - start;
+      return t.count() / (double(n) * repetitions);
+    }
+
+  [[gnu::noinline]] std::size_t
+  plain(const std::vector<double>& in, std::vector<float>& out)
+  {
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < in.size(); ++i)
+      {
+        const auto r = vir::value_preserving_cast<float>(in[i]);
+        failed += !r;
+        out[i] = r.value_or(0);
+      }
+    return failed;
+  }
+
+  constinit vir::cast_site site;
+
+  [[gnu::noinline]] std::size_t
+  counted(const std::vector<double>& in, std::vector<float>& out)
+  {
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < in.size(); ++i)
+      {
+        const auto r = vir::value_preserving_cast<float>(in[i], site);
+        failed += !r;
+        out[i] = r.value_or(0);
+      }
+    return failed;
+  }
+}
+
+int
+main()
+{
+  std::vector<double> in(n);
+  std::vector<float> out(n);
+  for (std::size_t i = 0; i < n; ++i)
+    in[i] = i % 64 == 0 ? 0.1 : double(i) * 0.25;
+
+  // alternate between the two loops, so that both see the same clock rate and noise
+  std::size_t sink = 0;
+  double t_plain = 1e9;
+  double t_counted = 1e9;
+  for (int run = 0; run < runs; ++run)
+    {
+      t_plain = std::min(t_plain, ns_per_element([&] { sink += plain(in, out); }));
+      t_counted = std::min(t_counted, ns_per_element([&] { sink += counted(in, out); }));
+    }
+  std::printf("value_preserving_cast<float>(double):          %.3f ns\n", t_plain);
+  std::printf("value_preserving_cast<float>(double, site):    %.3f ns\n", t_counted);
+  std::printf("overhead per check:                            %.3f ns\n", t_counted - t_plain);
+  return sink == 0;
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file at.h
+ * @brief Element access with indexes that are checked at compile time
+ *
+ * This header provides at(), which accesses an element of a std::array, a fixed-extent
+ * std::span, or a C array with an untyped constant (e.g. `3_val`) as index. The index is checked
+ * against the static extent at compile time, thus the access itself needs no bounds check, even
+ * with `_GLIBCXX_ASSERTIONS` (which checks every `operator[]`).
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_AT_H_
+#define INCLUDE_AT_H_
+
+#include "constant_wrapper.h"
+
+#ifdef vir_lib_val_literal
+
+#include <array>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+
+namespace vir
+{
+  /** @internal
+   * @brief The number of elements of @p _Tp if it is known at compile time, dynamic_extent
+   * otherwise.
+   */
+  template <typename _Tp>
+    inline constexpr size_t __static_size = std::dynamic_extent;
+
+  template <typename _Tp, size_t _Np>
+    inline constexpr size_t __static_size<std::array<_Tp, _Np>> = _Np;
+
+  template <typename _Tp, size_t _Np>
+    inline constexpr size_t __static_size<std::span<_Tp, _Np>> = _Np;
+
+  template <typename _Tp, size_t _Np>
+    inline constexpr size_t __static_size<_Tp[_Np]> = _Np;
+
+  /** @internal
+   * @brief Concept for ranges with a number of elements that is known at compile time.
+   */
+  template <typename _Tp>
+    concept __statically_sized
+      = __static_size<std::remove_cvref_t<_Tp>> != std::dynamic_extent;
+
+  /** @internal
+   * @brief Index into a range of @p _Np elements, checked when it is constructed (at compile
+   * time).
+   *
+   * Like _ConstBinaryOps::_ConvertTo, the consteval constructors turn the constant argument of a
+   * function into a value that the function can use without being immediate itself.
+   */
+  template <size_t _Np>
+    struct __static_index
+    {
+      const size_t _M_value;
+
+      /** @internal
+       * @brief Check @p __x (value-preserving conversion to size_t) against @p _Np.
+       *
+       * @throws bad_value_preserving_cast if @p __x is negative or not integral
+       * @throws std::out_of_range if @p __x is not less than @p _Np
+       */
+      consteval
+      __static_index(const constinteger& __x)
+      : _M_value(__x)
+      {
+        if (_M_value >= _Np)
+          throw std::out_of_range("vir::at: index out of range");
+      }
+
+      /** @internal
+       * @brief Check the untyped constant of a constant_wrapper.
+       */
+      template <constinteger _Xp>
+        consteval
+        __static_index(constant_wrapper<_Xp>)
+        : __static_index(_Xp)
+        {}
+    };
+
+  /**
+   * @brief Element @p __i of @p __r without runtime bounds check.
+   *
+   * @p __r is a std::array, a std::span with static extent, or a C array. The index is an
+   * untyped constant (`3_val`) or a constant_wrapper (`vir::cw<3_val>`), which must be less than
+   * the size of @p __r. Otherwise, the call is ill-formed.
+   *
+   * @code
+   * std::array<float, 4> v = ...;
+   * float s = vir::at(v, 0_val) + vir::at(v, 1_val) + vir::at(v, 2_val) + vir::at(v, 3_val);
+   * vir::at(v, 4_val); // ill-formed
+   * @endcode
+   *
+   * @param __r The range (only rvalues of std::span, since the reference would dangle otherwise)
+   * @param __i The index
+   * @return A reference to the element
+   */
+  template <__statically_sized _Rg>
+    requires std::ranges::borrowed_range<_Rg>
+    constexpr decltype(auto)
+    at(_Rg&& __r, __static_index<__static_size<std::remove_cvref_t<_Rg>>> __i) noexcept
+    { return std::ranges::data(__r)[__i._M_value]; }
+}
+
+#endif
+
+#endif  // INCLUDE_AT_H_
+
+// vim: ft=cpp
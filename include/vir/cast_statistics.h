@@ -0,0 +1,477 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file cast_statistics.h
+ * @brief Opt-in counters for value_preserving_cast attempts and failures per call site
+ *
+ * This header provides cast_site, which identifies a call site of value_preserving_cast by its
+ * source_location, and an overload of value_preserving_cast that counts the attempts and
+ * failures at that site. cast_statistics() and print_cast_statistics() report the counts.
+ *
+ * Every thread counts into its own (thread-local) counters and publishes them in batches, thus
+ * counting costs neither atomic read-modify-write operations nor cache-line transfers between
+ * threads.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_CAST_STATISTICS_H_
+#define INCLUDE_CAST_STATISTICS_H_
+
+#include "value_preserving_cast.h"
+
+#ifdef vir_lib_val_literal
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vir
+{
+  /** @internal
+   * @brief Returns the name of the arithmetic type @p _Tp (e.g. "int16", "double").
+   */
+  template <__vp_castable _Tp>
+    consteval std::string_view
+    __arithmetic_name() noexcept
+    {
+      if constexpr (std::same_as<_Tp, float>)
+        return "float";
+      else if constexpr (std::same_as<_Tp, double>)
+        return "double";
+      else if constexpr (std::same_as<_Tp, long double>)
+        return "long double";
+      else if constexpr (floating_point<_Tp>)
+        return "floating-point";
+      else
+        {
+          constexpr std::string_view __names[] = {"int8",  "uint8",  "int16",  "uint16",
+                                                  "int32", "uint32", "int64",  "uint64",
+                                                  "int128", "uint128"};
+          return __names[2 * std::countr_zero(sizeof(_Tp)) + !numeric_limits<_Tp>::is_signed];
+        }
+    }
+
+  /** @internal
+   * @brief The source and target type names of a conversion.
+   */
+  struct __cast_types
+  {
+    std::string_view _M_from;
+    std::string_view _M_to;
+  };
+
+  template <__vp_castable _To, __vp_castable _From>
+    inline constexpr __cast_types __cast_types_v
+      = {__arithmetic_name<_From>(), __arithmetic_name<_To>()};
+
+  /** @internal
+   * @brief Attempts and failures of one call site and type pair.
+   *
+   * A tally has a single writer at any time (the owning thread, or the holder of the registry
+   * mutex once the owner exited); other threads only read it. Therefore relaxed loads and stores
+   * (instead of read-modify-write operations) suffice.
+   */
+  struct __cast_tally
+  {
+    std::atomic<std::uint64_t> _M_attempts;
+    std::atomic<std::uint64_t> _M_failures;
+
+    void
+    _M_add_attempts(std::uint64_t __n) noexcept
+    {
+      _M_attempts.store(_M_attempts.load(std::memory_order_relaxed) + __n,
+                        std::memory_order_relaxed);
+    }
+
+    void
+    _M_add_failures(std::uint64_t __n) noexcept
+    {
+      _M_failures.store(_M_failures.load(std::memory_order_relaxed) + __n,
+                        std::memory_order_relaxed);
+    }
+  };
+
+  class cast_site;
+
+  /** @internal
+   * @brief The counts of one cast_site and type pair in one thread, or the merged counts of
+   * threads that exited.
+   */
+  struct __cast_counter
+  {
+    const cast_site* _M_site;
+    const __cast_types* _M_types;
+    source_location _M_where;
+    __cast_tally _M_tally = {};
+
+    /// Whether the counter belongs to no thread (anymore). Requires the registry mutex.
+    bool _M_retired = false;
+
+    /// The next counter of the same thread.
+    __cast_counter* _M_next = nullptr;
+  };
+
+  /** @internal
+   * @brief Number of attempts a thread counts locally before publishing them.
+   */
+  inline constexpr std::uint32_t __cast_flush_interval = 1024;
+
+  /** @internal
+   * @brief The call site a thread last counted for one type pair, and the attempts not yet
+   * published to its counter.
+   */
+  struct __cast_cache
+  {
+    const cast_site* _M_site;
+    __cast_counter* _M_counter;
+
+    /// Attempts until the next flush; __cast_flush_interval - _M_left are not yet published.
+    std::uint32_t _M_left;
+
+    /// The next cache in use by the same thread.
+    __cast_cache* _M_next;
+
+    [[gnu::cold]] void
+    _M_flush() noexcept
+    {
+      _M_counter->_M_tally._M_add_attempts(__cast_flush_interval - _M_left);
+      _M_left = __cast_flush_interval;
+    }
+  };
+
+  /** @internal
+   * @brief The cache of the current thread for conversions from _From to _To.
+   */
+  template <typename _To, typename _From>
+    inline thread_local constinit __cast_cache __tls_cast_cache = {};
+
+  /** @internal
+   * @brief The counters and caches of the current thread.
+   */
+  struct __cast_thread
+  {
+    __cast_counter* _M_counters;
+    __cast_cache* _M_caches;
+
+    /// 0 before the first count, 1 while counting, 2 after the thread's exit handler ran.
+    unsigned char _M_state;
+  };
+
+  inline thread_local constinit __cast_thread __tls_cast_thread = {};
+
+  /** @internal
+   * @brief All counters of all threads.
+   */
+  struct __cast_registry
+  {
+    std::mutex _M_mutex;
+    std::vector<__cast_counter*> _M_counters;
+
+    /** @internal
+     * @brief Returns the retired counter with the site and types of @p __key, or nullptr.
+     * Requires the mutex.
+     */
+    __cast_counter*
+    _M_find_retired(const __cast_counter& __key) const noexcept
+    {
+      for (__cast_counter* __c : _M_counters)
+        if (__c->_M_retired && __c->_M_site == __key._M_site && __c->_M_types == __key._M_types)
+          return __c;
+      return nullptr;
+    }
+  };
+
+  /** @internal
+   * @brief The registry, constructed on first use.
+   *
+   * It is never destroyed, because conversions may still be counted while static objects are
+   * destroyed.
+   */
+  inline __cast_registry&
+  __get_cast_registry()
+  {
+    static __cast_registry& __r = *new __cast_registry;
+    return __r;
+  }
+
+  /** @internal
+   * @brief Publish the counts of the current thread. Requires the registry mutex.
+   */
+  inline void
+  __flush_cast_thread() noexcept
+  {
+    for (__cast_cache* __c = __tls_cast_thread._M_caches; __c; __c = __c->_M_next)
+      __c->_M_flush();
+  }
+
+  /** @internal
+   * @brief At thread exit, publish the counts of the thread and merge its counters into the
+   * retired counters.
+   */
+  struct __cast_thread_exit
+  {
+    ~__cast_thread_exit()
+    {
+      __cast_registry& __reg = __get_cast_registry();
+      std::lock_guard __lock(__reg._M_mutex);
+      __cast_thread& __t = __tls_cast_thread;
+      __flush_cast_thread();
+      for (__cast_cache* __c = __t._M_caches; __c;)
+        __c = std::exchange(*__c, {})._M_next;
+      for (__cast_counter* __c = __t._M_counters; __c;)
+        {
+          __cast_counter* __next = std::exchange(__c->_M_next, nullptr);
+          if (__cast_counter* __r = __reg._M_find_retired(*__c))
+            {
+              __r->_M_tally._M_add_attempts(__c->_M_tally._M_attempts.load(std::memory_order_relaxed));
+              __r->_M_tally._M_add_failures(__c->_M_tally._M_failures.load(std::memory_order_relaxed));
+              std::erase(__reg._M_counters, __c);
+              delete __c;
+            }
+          else
+            __c->_M_retired = true;
+          __c = __next;
+        }
+      __t = {nullptr, nullptr, 2};
+    }
+  };
+
+  /** @internal
+   * @brief Count one conversion at @p __site from a different cache (the slow path of
+   * cast_site::_M_count): publish the counts of the previous site and switch @p __cache to the
+   * counter of @p __site and @p __types, which is registered on first use.
+   */
+  [[gnu::cold]] inline void
+  __cast_switch(__cast_cache& __cache, const cast_site& __site, source_location __where,
+                const __cast_types& __types, bool __failed) noexcept
+  {
+    __cast_registry& __reg = __get_cast_registry();
+    __cast_thread& __t = __tls_cast_thread;
+    if (__t._M_state == 2) [[unlikely]]
+      {
+        // the thread is exiting: count without cache
+        std::lock_guard __lock(__reg._M_mutex);
+        __cast_counter* __r = __reg._M_find_retired({&__site, &__types, __where});
+        if (!__r)
+          {
+            __r = new __cast_counter{&__site, &__types, __where};
+            __r->_M_retired = true;
+            __reg._M_counters.push_back(__r);
+          }
+        __r->_M_tally._M_add_attempts(1);
+        if (__failed)
+          __r->_M_tally._M_add_failures(1);
+        return;
+      }
+    if (__t._M_state == 0)
+      {
+        static thread_local __cast_thread_exit __exit;
+        __t._M_state = 1;
+      }
+    if (__cache._M_counter)
+      __cache._M_flush();
+    else
+      {
+        __cache._M_next = __t._M_caches;
+        __t._M_caches = &__cache;
+      }
+    __cast_counter* __c = __t._M_counters;
+    while (__c && (__c->_M_site != &__site || __c->_M_types != &__types))
+      __c = __c->_M_next;
+    if (!__c)
+      {
+        __c = new __cast_counter{&__site, &__types, __where};
+        __c->_M_next = __t._M_counters;
+        __t._M_counters = __c;
+        std::lock_guard __lock(__reg._M_mutex);
+        __reg._M_counters.push_back(__c);
+      }
+    __cache._M_site = &__site;
+    __cache._M_counter = __c;
+    __cache._M_left = __cast_flush_interval - 1;
+    if (__failed)
+      __c->_M_tally._M_add_failures(1);
+  }
+
+  /**
+   * @brief A call site of value_preserving_cast, identified by its source location.
+   *
+   * Declare a cast_site at namespace scope and pass it to value_preserving_cast to count the
+   * conversions and failures there:
+   *
+   * @code
+   * constinit vir::cast_site narrow_site;
+   *
+   * float
+   * narrow(double x)
+   * { return vir::value_preserving_cast<float>(x, narrow_site).value_or(0); }
+   * @endcode
+   *
+   * The source location is where the cast_site is constructed. The counts are kept per pair of
+   * source and target type, thus a site used for several conversions reports each of them.
+   *
+   * The constructor is constexpr and the destructor is trivial, thus a cast_site is
+   * constant-initialized and costs no guard check; a function-local `static` cast_site works as
+   * well. A cast_site must have static storage duration. cast_statistics() only reports sites
+   * that have counted at least once.
+   */
+  class cast_site
+  {
+    source_location _M_where;
+
+  public:
+    explicit constexpr
+    cast_site(source_location __where = source_location::current()) noexcept
+    : _M_where(__where)
+    {}
+
+    cast_site(const cast_site&) = delete;
+
+    cast_site& operator=(const cast_site&) = delete;
+
+    /**
+     * @brief Where the cast_site was constructed.
+     */
+    constexpr source_location
+    where() const noexcept
+    { return _M_where; }
+
+    /** @internal
+     * @brief Count one conversion from _From to _To.
+     *
+     * Only a different site (or type pair) than the previous count of the thread, a failure,
+     * and every __cast_flush_interval-th count leave the inline path.
+     */
+    template <typename _To, typename _From>
+      void
+      _M_count(bool __failed) noexcept
+      {
+        __cast_cache& __c = __tls_cast_cache<_To, _From>;
+        if (__c._M_site == this) [[likely]]
+          {
+            if (--__c._M_left == 0) [[unlikely]]
+              __c._M_flush();
+            if (__failed) [[unlikely]]
+              __c._M_counter->_M_tally._M_add_failures(1);
+          }
+        else
+          __cast_switch(__c, *this, _M_where, __cast_types_v<_To, _From>, __failed);
+      }
+  };
+
+  /**
+   * @brief Like value_preserving_cast(_From), and counts the attempt (and failure) at @p __site.
+   *
+   * As long as a thread converts the same pair of types at the same site, counting compares the
+   * site against the one cached per thread and type pair and decrements a thread-local counter;
+   * the attempts are published every 1024 conversions. In a loop that does nothing but convert,
+   * bench/cast_statistics.cpp measured 0.6 to 0.8 ns per count on a 2 GHz x86-64 core (GCC,
+   * -O3). Alternating between sites with the same types in one thread takes the slow path on
+   * every count.
+   *
+   * @tparam _To Target arithmetic type
+   * @param __x Value to convert
+   * @param __site The call site (see cast_site)
+   * @return std::expected<_To, cast_error> The converted value or the reason of failure
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    std::expected<_To, cast_error>
+    value_preserving_cast(_From __x, cast_site& __site) noexcept
+    {
+      const __vp_result<_To> __r = __vp_convert<_To>(__x);
+      __site._M_count<_To, _From>(__r._M_error != 0);
+      if (__r._M_error != 0) [[unlikely]]
+        return std::unexpected(static_cast<cast_error>(__r._M_error));
+      return __r._M_value;
+    }
+
+  /**
+   * @brief Counts of one cast_site and type pair.
+   */
+  struct cast_site_statistics
+  {
+    /// Where the cast_site was constructed.
+    source_location where;
+
+    /// Name of the source type (e.g. "double").
+    std::string_view from;
+
+    /// Name of the target type (e.g. "float").
+    std::string_view to;
+
+    /// Number of conversions.
+    std::uint64_t attempts;
+
+    /// Number of conversions that were not value-preserving.
+    std::uint64_t failures;
+  };
+
+  /**
+   * @brief Returns the counts of all cast_site objects and type pairs that counted at least once
+   * (summed over all threads).
+   *
+   * Failures are exact, and so are the attempts of the calling thread and of threads that
+   * exited. Other threads publish their attempts in batches of 1024 per site and type pair.
+   */
+  inline std::vector<cast_site_statistics>
+  cast_statistics()
+  {
+    __cast_registry& __reg = __get_cast_registry();
+    std::lock_guard __lock(__reg._M_mutex);
+    if (__tls_cast_thread._M_state == 1)
+      __flush_cast_thread();
+    std::vector<cast_site_statistics> __r;
+    std::vector<const __cast_counter*> __keys;
+    for (const __cast_counter* __c : __reg._M_counters)
+      {
+        const auto __same = [__c](const __cast_counter* __k) {
+          return __k->_M_site == __c->_M_site && __k->_M_types == __c->_M_types;
+        };
+        const size_t __i = size_t(std::ranges::find_if(__keys, __same) - __keys.begin());
+        if (__i == __keys.size())
+          {
+            __keys.push_back(__c);
+            __r.push_back({__c->_M_where, __c->_M_types->_M_from, __c->_M_types->_M_to, 0, 0});
+          }
+        __r[__i].attempts += __c->_M_tally._M_attempts.load(std::memory_order_relaxed);
+        __r[__i].failures += __c->_M_tally._M_failures.load(std::memory_order_relaxed);
+      }
+    return __r;
+  }
+
+  /**
+   * @brief Print the counts of all cast_site objects with at least one attempt, most failures
+   * first.
+   *
+   * One line per call site and type pair: `file:line:column: from -> to: F of A failed`.
+   */
+  inline void
+  print_cast_statistics(std::FILE* __out = stderr)
+  {
+    std::vector<cast_site_statistics> __stats = cast_statistics();
+    std::ranges::stable_sort(__stats, std::ranges::greater(), &cast_site_statistics::failures);
+    for (const cast_site_statistics& __s : __stats)
+      if (__s.attempts != 0)
+        std::fprintf(__out, "%s:%u:%u: %.*s -> %.*s: %llu of %llu failed\n",
+                     __s.where.file_name(), unsigned(__s.where.line()),
+                     unsigned(__s.where.column()), int(__s.from.size()), __s.from.data(),
+                     int(__s.to.size()), __s.to.data(),
+                     static_cast<unsigned long long>(__s.failures),
+                     static_cast<unsigned long long>(__s.attempts));
+  }
+}
+
+#endif
+
+#endif  // INCLUDE_CAST_STATISTICS_H_
+
+// vim: ft=cpp
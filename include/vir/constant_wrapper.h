@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file constant_wrapper.h
+ * @brief Untyped constants encoded in the type system
+ *
+ * This header provides constant_wrapper and cw, which lift an untyped constant (e.g. `8_val`)
+ * into a type, like std::integral_constant and C++26 std::constant_wrapper do for typed values.
+ * Generic code can thus specialize on the value (unroll factors, strides, power-of-two fast
+ * paths), while every conversion to an arithmetic type is still value-preserving and checked at
+ * compile time.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_CONSTANT_WRAPPER_H_
+#define INCLUDE_CONSTANT_WRAPPER_H_
+
+#include "val.h"
+
+#ifdef vir_lib_val_literal
+
+#include <type_traits>
+
+namespace vir
+{
+  /** @internal
+   * @brief Concept for the untyped constant types (constinteger, constreal, ...).
+   */
+  template <typename _Tp>
+    concept __untyped_constant = std::derived_from<_Tp, _ConstBinaryOps>;
+
+  /** @internal
+   * @brief Helper for __value_preserving: only well-formed if @p _Xp converts to @p _Tp.
+   */
+  template <typename _Tp, _Tp _Xp>
+    struct __nttp {};
+
+  /** @internal
+   * @brief Whether the untyped constant @p _Xp converts to @p _Tp (value-preserving).
+   */
+  template <typename _Tp, auto _Xp>
+    concept __value_preserving = requires { typename __nttp<_Tp, _Xp>; };
+
+  template <__untyped_constant auto _Xp>
+    struct constant_wrapper;
+
+  /** @internal
+   * @brief Whether @p _Tp is a specialization of constant_wrapper.
+   */
+  template <typename _Tp>
+    inline constexpr bool __is_constant_wrapper = false;
+
+  template <auto _Xp>
+    inline constexpr bool __is_constant_wrapper<constant_wrapper<_Xp>> = true;
+
+  /**
+   * @brief An untyped constant as type.
+   *
+   * Objects of this type are empty. They convert implicitly to every arithmetic type that
+   * preserves the value, and to the corresponding std::integral_constant. Arithmetic with other
+   * constant_wrappers yields a constant_wrapper, where the untyped constants support it (`+`,
+   * `-`, and `*` of integers, `/` of integers and rationals). Two constant_wrappers of integers
+   * or rationals compare by their exact values. Arithmetic and comparisons with other values
+   * behave like with @c value.
+   *
+   * @code
+   * template <typename Stride>
+   *   float
+   *   sum4(const float* x, Stride stride)
+   *   {
+   *     float s = 0;
+   *     for (int i = 0; i < 4; ++i)
+   *       s += x[i * stride];
+   *     return s;
+   *   }
+   *
+   * sum4(data, vir::cw<8_val>); // stride is known at compile time
+   * @endcode
+   *
+   * @tparam _Xp The untyped constant (constinteger, constreal, constrational, or constrounded)
+   */
+  template <__untyped_constant auto _Xp>
+    struct constant_wrapper
+    {
+      /// The type of the untyped constant
+      using value_type = std::remove_const_t<decltype(_Xp)>;
+
+      using type = constant_wrapper;
+
+      /// The untyped constant
+      static constexpr value_type value = _Xp;
+
+      /// @internal The value converted to @p _Up
+      template <__arithmetic _Up>
+        static constexpr _Up _S_as = _Xp;
+
+      /**
+       * @brief Value-preserving conversion to an arithmetic type.
+       */
+      template <__arithmetic _Up>
+        requires __value_preserving<_Up, _Xp>
+        constexpr
+        operator _Up() const noexcept
+        { return _S_as<_Up>; }
+
+      /**
+       * @brief Value-preserving conversion to std::integral_constant.
+       */
+      template <integral _Up, _Up _Vp>
+        requires __value_preserving<_Up, _Xp> && (_Vp == _Xp)
+        constexpr
+        operator std::integral_constant<_Up, _Vp>() const noexcept
+        { return {}; }
+
+      friend constexpr constant_wrapper<-_Xp>
+      operator-(constant_wrapper) noexcept
+      { return {}; }
+
+      friend constexpr constant_wrapper
+      operator+(constant_wrapper) noexcept
+      { return {}; }
+
+#define _GLIBCXX_CW_OP(op)                                                                         \
+      template <auto _Yp>                                                                          \
+        friend constexpr constant_wrapper<(_Xp op _Yp)>                                            \
+        operator op(constant_wrapper, constant_wrapper<_Yp>) noexcept                              \
+        { return {}; }                                                                             \
+                                                                                                   \
+      template <typename _Tp>                                                                      \
+        requires (!__is_constant_wrapper<_Tp>) && requires(const _Tp& __a) { __a op _Xp; }        \
+        friend constexpr decltype(auto)                                                            \
+        operator op(const _Tp& __a, constant_wrapper) noexcept                                     \
+        { return __a op value; }                                                                   \
+                                                                                                   \
+      template <typename _Tp>                                                                      \
+        requires (!__is_constant_wrapper<_Tp>) && requires(const _Tp& __b) { _Xp op __b; }        \
+        friend constexpr decltype(auto)                                                            \
+        operator op(constant_wrapper, const _Tp& __b) noexcept                                     \
+        { return value op __b; }
+
+      _GLIBCXX_CW_OP(+)
+      _GLIBCXX_CW_OP(-)
+      _GLIBCXX_CW_OP(*)
+      _GLIBCXX_CW_OP(/)
+      _GLIBCXX_CW_OP(%)
+      _GLIBCXX_CW_OP(&)
+      _GLIBCXX_CW_OP(|)
+      _GLIBCXX_CW_OP(^)
+
+#undef _GLIBCXX_CW_OP
+
+#define _GLIBCXX_CW_CMP(op)                                                                        \
+      template <auto _Yp>                                                                          \
+        requires __exact_constant<value_type>                                                      \
+                   && __exact_constant<typename constant_wrapper<_Yp>::value_type>                 \
+        friend constexpr bool                                                                      \
+        operator op(constant_wrapper, constant_wrapper<_Yp>) noexcept                              \
+        { return __compare(_Xp, _Yp) op 0; }                                                       \
+                                                                                                   \
+      template <typename _Tp>                                                                      \
+        requires (!__is_constant_wrapper<_Tp>) && requires(const _Tp& __a) { __a op _Xp; }        \
+        friend constexpr bool                                                                      \
+        operator op(const _Tp& __a, constant_wrapper) noexcept                                     \
+        { return __a op value; }                                                                   \
+                                                                                                   \
+      template <typename _Tp>                                                                      \
+        requires (!__is_constant_wrapper<_Tp>) && requires(const _Tp& __b) { _Xp op __b; }        \
+        friend constexpr bool                                                                      \
+        operator op(constant_wrapper, const _Tp& __b) noexcept                                     \
+        { return value op __b; }
+
+      _GLIBCXX_CW_CMP(==)
+      _GLIBCXX_CW_CMP(!=)
+      _GLIBCXX_CW_CMP(<=)
+      _GLIBCXX_CW_CMP(>=)
+      _GLIBCXX_CW_CMP(<)
+      _GLIBCXX_CW_CMP(>)
+
+#undef _GLIBCXX_CW_CMP
+
+      /**
+       * @brief Compound assignment of the value to @p __a.
+       */
+#define _GLIBCXX_CW_ASSIGN(op)                                                                     \
+      template <typename _Tp>                                                                      \
+        requires (!__is_constant_wrapper<_Tp>) && requires(_Tp& __a) { __a op##= _Xp; }          \
+        friend constexpr _Tp&                                                                      \
+        operator op##=(_Tp& __a, constant_wrapper) noexcept                                        \
+        { return __a op##= value; }
+
+      _GLIBCXX_CW_ASSIGN(+)
+      _GLIBCXX_CW_ASSIGN(-)
+      _GLIBCXX_CW_ASSIGN(*)
+      _GLIBCXX_CW_ASSIGN(/)
+      _GLIBCXX_CW_ASSIGN(%)
+      _GLIBCXX_CW_ASSIGN(&)
+      _GLIBCXX_CW_ASSIGN(|)
+      _GLIBCXX_CW_ASSIGN(^)
+
+#undef _GLIBCXX_CW_ASSIGN
+    };
+
+  /** @internal
+   * @brief The untyped constant for @p __x: an untyped constant itself, an integral or
+   * floating-point value (via val()), or the static @c value member of a type such as
+   * std::integral_constant or std::constant_wrapper.
+   */
+  template <typename _Tp>
+    consteval auto
+    __to_untyped(const _Tp& __x)
+    {
+      if constexpr (__untyped_constant<_Tp>)
+        return __x;
+      else if constexpr (__arithmetic<_Tp> && !std::same_as<_Tp, bool>)
+        return val(__x);
+      else
+        return __to_untyped(_Tp::value);
+    }
+
+  /**
+   * @brief The constant_wrapper object for @p _Xp.
+   *
+   * @p _Xp is an untyped constant (`vir::cw<8_val>`), an integral or floating-point constant
+   * (`vir::cw<8>`), or an object of a type with a static @c value member, such as
+   * std::integral_constant or std::constant_wrapper (`vir::cw<std::integral_constant<int, 8>{}>`).
+   */
+  template <auto _Xp>
+    inline constexpr constant_wrapper<__to_untyped(_Xp)> cw {};
+}
+
+#endif
+
+#endif  // INCLUDE_CONSTANT_WRAPPER_H_
+
+// vim: ft=cpp
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file extents.h
+ * @brief Static std::mdspan extents and strides from untyped constants
+ *
+ * This header provides extents and basic_extents, which turn untyped constants (e.g. `4_val`)
+ * into static std::extents, and layout_static_stride, a std::mdspan layout with strides fixed at
+ * compile time. Every extent and stride is converted to the index type with the value-preserving
+ * checks of constinteger, thus the index type can be chosen freely without spelling every
+ * constant with the matching type.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_EXTENTS_H_
+#define INCLUDE_EXTENTS_H_
+
+#include "constant_wrapper.h"
+
+#ifdef vir_lib_val_literal
+
+#include <array>
+#include <mdspan>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace vir
+{
+  /** @internal
+   * @brief Returns std::dynamic_extent if @p _Xp is std::dynamic_extent. Otherwise, returns the
+   * value of @p _Xp after checking that it is a non-negative value of type @p _IndexType.
+   *
+   * @throws bad_value_preserving_cast if @p _Xp is not representable as @p _IndexType
+   * @throws std::domain_error if @p _Xp is negative
+   */
+  template <integral _IndexType, auto _Xp>
+    consteval size_t
+    __static_extent()
+    {
+      if constexpr (std::same_as<decltype(_Xp), size_t>)
+        if (_Xp == std::dynamic_extent)
+          return std::dynamic_extent;
+      const _IndexType __e = __to_untyped(_Xp);
+      if (__e < 0)
+        throw std::domain_error("vir::extents: extent must not be negative");
+      return static_cast<size_t>(__e);
+    }
+
+  /**
+   * @brief std::extents with index type @p _IndexType and the extents @p _Exts.
+   *
+   * Every extent is an untyped constant (`4_val`), a constant_wrapper, an integral constant of any
+   * type, or std::dynamic_extent. It must be representable as @p _IndexType.
+   *
+   * @code
+   * using state_cov = vir::basic_extents<int, 5_val, 5_val>; // std::extents<int, 5, 5>
+   * @endcode
+   */
+  template <integral _IndexType, auto... _Exts>
+    using basic_extents = std::extents<_IndexType, __static_extent<_IndexType, _Exts>()...>;
+
+  /**
+   * @brief basic_extents with index type std::size_t.
+   *
+   * @code
+   * std::mdspan m(data, vir::extents<3_val, 3_val>()); // std::extents<std::size_t, 3, 3>
+   * @endcode
+   */
+  template <auto... _Exts>
+    using extents = basic_extents<size_t, _Exts...>;
+
+  /**
+   * @brief std::mdspan layout with strides that are known at compile time.
+   *
+   * Like std::layout_stride, except that the strides are part of the type (and the mapping only
+   * stores the extents). Each stride is converted to the index type of the extents with the
+   * value-preserving checks of constinteger and must be positive.
+   *
+   * is_unique() and is_exhaustive() are reported conservatively as false.
+   *
+   * @code
+   * // every other column of a 3x6 row-major matrix
+   * using layout = vir::layout_static_stride<6_val, 2_val>;
+   * std::mdspan<float, vir::extents<3_val, 3_val>, layout> m(data);
+   * @endcode
+   *
+   * @tparam _Strides One stride per rank (untyped constants or integral constants)
+   */
+  template <auto... _Strides>
+    struct layout_static_stride
+    {
+      template <typename _Extents>
+        class mapping
+        {
+        public:
+          using extents_type = _Extents;
+          using index_type = typename extents_type::index_type;
+          using size_type = typename extents_type::size_type;
+          using rank_type = typename extents_type::rank_type;
+          using layout_type = layout_static_stride;
+
+        private:
+          static_assert(sizeof...(_Strides) == extents_type::rank(),
+                        "vir::layout_static_stride: one stride per rank is required");
+
+          static consteval std::array<index_type, sizeof...(_Strides)>
+          _S_make_strides()
+          {
+            std::array<index_type, sizeof...(_Strides)> __r = {
+              static_cast<index_type>(__to_untyped(_Strides))...};
+            for (index_type __s : __r)
+              if (__s <= 0)
+                throw std::domain_error("vir::layout_static_stride: strides must be positive");
+            return __r;
+          }
+
+          static constexpr std::array<index_type, sizeof...(_Strides)> _S_strides
+            = _S_make_strides();
+
+          extents_type _M_extents;
+
+        public:
+          constexpr
+          mapping() noexcept = default;
+
+          constexpr
+          mapping(const extents_type& __e) noexcept
+          : _M_extents(__e)
+          {}
+
+          constexpr const extents_type&
+          extents() const noexcept
+          { return _M_extents; }
+
+          constexpr index_type
+          required_span_size() const noexcept
+          {
+            index_type __r = 1;
+            for (rank_type __i = 0; __i < extents_type::rank(); ++__i)
+              {
+                if (_M_extents.extent(__i) == 0)
+                  return 0;
+                __r = static_cast<index_type>(__r + (_M_extents.extent(__i) - 1) * _S_strides[__i]);
+              }
+            return __r;
+          }
+
+          template <typename... _Indices>
+            requires (sizeof...(_Indices) == extents_type::rank())
+            constexpr index_type
+            operator()(_Indices... __i) const noexcept
+          {
+            return [&]<size_t... _Rs>(std::index_sequence<_Rs...>) {
+              return static_cast<index_type>(
+                       (index_type(0) + ... + (static_cast<index_type>(__i) * _S_strides[_Rs])));
+            }(std::make_index_sequence<sizeof...(_Indices)>());
+          }
+
+          static constexpr bool
+          is_always_unique() noexcept
+          { return false; }
+
+          static constexpr bool
+          is_always_exhaustive() noexcept
+          { return false; }
+
+          static constexpr bool
+          is_always_strided() noexcept
+          { return true; }
+
+          static constexpr bool
+          is_unique() noexcept
+          { return false; }
+
+          static constexpr bool
+          is_exhaustive() noexcept
+          { return false; }
+
+          static constexpr bool
+          is_strided() noexcept
+          { return true; }
+
+          static constexpr index_type
+          stride(rank_type __r) noexcept
+          { return _S_strides[__r]; }
+
+          friend constexpr bool
+          operator==(const mapping& __a, const mapping& __b) noexcept
+          { return __a._M_extents == __b._M_extents; }
+        };
+    };
+}
+
+#endif
+
+#endif  // INCLUDE_EXTENTS_H_
+
+// vim: ft=cpp
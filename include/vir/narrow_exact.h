@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file narrow_exact.h
+ * @brief Bulk value-preserving conversion of arrays
+ *
+ * This header provides narrow_exact, which converts an array element-wise (as
+ * value_preserving_cast does) and reports the elements that were not preserved. Conversion and
+ * verification happen in the same pass over the data. Optionally, the work is split into chunks
+ * processed by several threads.
+ *
+ * The inner loop is written for auto-vectorization (no branches per element), so that the
+ * compiler emits SSE, AVX2, or AVX-512 code according to the target flags, or scalar code
+ * otherwise. Conversions from float and double avoid conditional floating-point conversions, so
+ * that vectorization does not depend on `-fno-trapping-math`.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_NARROW_EXACT_H_
+#define INCLUDE_NARROW_EXACT_H_
+
+#include "value_preserving_cast.h"
+
+#ifdef vir_lib_val_literal
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace vir
+{
+  /**
+   * @brief Policy for narrow_exact: split the input into chunks and process them concurrently.
+   *
+   * A value of 0 for @c threads uses std::thread::hardware_concurrency(). Inputs that are too
+   * small to benefit from more threads use fewer (down to one, i.e. no additional thread).
+   */
+  struct parallel
+  {
+    unsigned threads = 0;
+  };
+
+  /** @internal
+   * @brief Number of elements converted before checking for lossy elements. Equal to the number
+   * of bits in one word of the lossy-element bitmap.
+   */
+  inline constexpr size_t __narrow_block_size = 64;
+
+  /** @internal
+   * @brief Minimal number of elements per thread for parallel narrow_exact.
+   */
+  inline constexpr size_t __narrow_min_chunk = size_t(1) << 16;
+
+  /** @internal
+   * @brief Convert @p __n (at most __narrow_block_size) elements; returns whether any of them
+   * is not preserved.
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    inline bool
+    __narrow_block(const _From* __in, _To* __out, size_t __n) noexcept
+    {
+      unsigned char __lossy = 0;
+      for (size_t __i = 0; __i < __n; ++__i)
+        {
+          const __vp_result<_To> __r = __vp_convert<_To>(__in[__i]);
+          __out[__i] = __r._M_value;
+          __lossy |= __r._M_error;
+        }
+      return __lossy != 0;
+    }
+
+  /** @internal
+   * @brief Returns the bitmask of the elements in @p __in[0:__n] that are not preserved.
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    inline std::uint64_t
+    __lossy_mask(const _From* __in, size_t __n) noexcept
+    {
+      std::uint64_t __mask = 0;
+      for (size_t __i = 0; __i < __n; ++__i)
+        if (__vp_convert<_To>(__in[__i])._M_error != 0)
+          __mask |= std::uint64_t(1) << __i;
+      return __mask;
+    }
+
+  /** @internal
+   * @brief Convert [__begin, __end) and return the index of the first lossy element or @p __end.
+   *
+   * Stops early (returning @p __end) once @p __stop holds an index less than or equal to the
+   * current position.
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    size_t
+    __narrow_first(const _From* __in, _To* __out, size_t __begin, size_t __end,
+                   const std::atomic<size_t>* __stop = nullptr) noexcept
+    {
+      for (size_t __i = __begin; __i < __end; __i += __narrow_block_size)
+        {
+          if (__stop && __stop->load(std::memory_order_relaxed) <= __i)
+            return __end;
+          const size_t __n = std::min(__narrow_block_size, __end - __i);
+          if (__narrow_block(__in + __i, __out + __i, __n)) [[unlikely]]
+            return __i + size_t(std::countr_zero(__lossy_mask<_To>(__in + __i, __n)));
+        }
+      return __end;
+    }
+
+  /** @internal
+   * @brief Convert [__begin, __end), set the bits of lossy elements in @p __bitmap, and return
+   * their number. @p __begin must be a multiple of __narrow_block_size.
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    size_t
+    __narrow_bitmap(const _From* __in, _To* __out, std::uint64_t* __bitmap, size_t __begin,
+                    size_t __end) noexcept
+    {
+      size_t __count = 0;
+      for (size_t __i = __begin; __i < __end; __i += __narrow_block_size)
+        {
+          const size_t __n = std::min(__narrow_block_size, __end - __i);
+          std::uint64_t __mask = 0;
+          if (__narrow_block(__in + __i, __out + __i, __n)) [[unlikely]]
+            {
+              __mask = __lossy_mask<_To>(__in + __i, __n);
+              __count += size_t(std::popcount(__mask));
+            }
+          __bitmap[__i / __narrow_block_size] = __mask;
+        }
+      return __count;
+    }
+
+  /** @internal
+   * @brief Number of threads to use for @p __size elements.
+   */
+  inline size_t
+  __thread_count(parallel __policy, size_t __size) noexcept
+  {
+    const size_t __threads = __policy.threads != 0
+                               ? __policy.threads
+                               : std::max(1u, std::thread::hardware_concurrency());
+    return std::clamp(__size / __narrow_min_chunk, size_t(1), __threads);
+  }
+
+  /** @internal
+   * @brief Call @p __fun(__begin, __end, __thread_index) for chunks of [0, __size) (multiples of
+   * __narrow_block_size) on @p __threads threads, including the calling thread.
+   */
+  template <typename _Fp>
+    void
+    __for_each_chunk(size_t __threads, size_t __size, _Fp&& __fun)
+    {
+      const size_t __blocks = (__size + __narrow_block_size - 1) / __narrow_block_size;
+      const size_t __chunk = (__blocks + __threads - 1) / __threads * __narrow_block_size;
+      std::vector<std::jthread> __workers;
+      __workers.reserve(__threads - 1);
+      for (size_t __t = 1; __t < __threads; ++__t)
+        {
+          const size_t __begin = std::min(__size, __t * __chunk);
+          const size_t __end = std::min(__size, __begin + __chunk);
+          __workers.emplace_back([&__fun, __begin, __end, __t] { __fun(__begin, __end, __t); });
+        }
+      __fun(size_t(0), std::min(__size, __chunk), size_t(0));
+    }
+
+  /**
+   * @brief Convert @p __in element-wise to @p __out and return the index of the first element
+   * that is not preserved.
+   *
+   * The rules are those of value_preserving_cast. All elements before the returned index are
+   * converted; the contents of @p __out after the returned index are unspecified.
+   *
+   * @code
+   * std::vector<double> in = ...;
+   * std::vector<float> out(in.size());
+   * if (vir::narrow_exact(std::span<const double>(in), std::span(out)) == in.size())
+   *   // all values are representable as float
+   * @endcode
+   *
+   * @param __in  Values to convert
+   * @param __out Destination
+   * @return size_t The index of the first lossy element, or @p __in.size() if all are preserved
+   * @pre `__out.size() >= __in.size()`; otherwise executes a trap instruction
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    size_t
+    narrow_exact(std::span<const _From> __in, std::span<_To> __out) noexcept
+    {
+      if (__out.size() < __in.size()) [[unlikely]]
+        __builtin_trap();
+      return __narrow_first(__in.data(), __out.data(), 0, __in.size());
+    }
+
+  /**
+   * @brief Like narrow_exact(std::span<const _From>, std::span<_To>), split into chunks processed
+   * concurrently.
+   *
+   * Threads stop early once a lossy element in an earlier chunk was found.
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    size_t
+    narrow_exact(parallel __policy, std::span<const _From> __in, std::span<_To> __out)
+    {
+      if (__out.size() < __in.size()) [[unlikely]]
+        __builtin_trap();
+      std::atomic<size_t> __first = __in.size();
+      const size_t __threads = __thread_count(__policy, __in.size());
+      __for_each_chunk(__threads, __in.size(), [&](size_t __begin, size_t __end, size_t) {
+        const size_t __i = __narrow_first(__in.data(), __out.data(), __begin, __end, &__first);
+        size_t __cur = __first.load(std::memory_order_relaxed);
+        while (__i != __end && __i < __cur && !__first.compare_exchange_weak(__cur, __i, std::memory_order_relaxed))
+          ;
+      });
+      return __first.load(std::memory_order_relaxed);
+    }
+
+  /**
+   * @brief Convert all of @p __in element-wise to @p __out and mark the elements that are not
+   * preserved in @p __lossy.
+   *
+   * Bit @c i%64 of @p __lossy[i/64] is set if and only if element @c i is not preserved. The
+   * converted value of such an element is unspecified.
+   *
+   * @param __in    Values to convert
+   * @param __out   Destination
+   * @param __lossy Bitmap of lossy elements
+   * @return size_t The number of lossy elements
+   * @pre `__out.size() >= __in.size()` and `__lossy.size() >= (__in.size() + 63) / 64`;
+   * otherwise executes a trap instruction
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    size_t
+    narrow_exact(std::span<const _From> __in, std::span<_To> __out,
+                 std::span<std::uint64_t> __lossy) noexcept
+    {
+      if (__out.size() < __in.size() || __lossy.size() < (__in.size() + 63) / 64) [[unlikely]]
+        __builtin_trap();
+      return __narrow_bitmap(__in.data(), __out.data(), __lossy.data(), 0, __in.size());
+    }
+
+  /**
+   * @brief Like narrow_exact(std::span<const _From>, std::span<_To>, std::span<std::uint64_t>),
+   * split into chunks processed concurrently.
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    size_t
+    narrow_exact(parallel __policy, std::span<const _From> __in, std::span<_To> __out,
+                 std::span<std::uint64_t> __lossy)
+    {
+      if (__out.size() < __in.size() || __lossy.size() < (__in.size() + 63) / 64) [[unlikely]]
+        __builtin_trap();
+      const size_t __threads = __thread_count(__policy, __in.size());
+      std::vector<size_t> __counts(__threads);
+      __for_each_chunk(__threads, __in.size(), [&](size_t __begin, size_t __end, size_t __t) {
+        __counts[__t] = __narrow_bitmap(__in.data(), __out.data(), __lossy.data(), __begin, __end);
+      });
+      return std::reduce(__counts.begin(), __counts.end());
+    }
+}
+
+#endif
+
+#endif  // INCLUDE_NARROW_EXACT_H_
+
+// vim: ft=cpp
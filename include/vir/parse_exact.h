@@ -0,0 +1,754 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file parse_exact.h
+ * @brief Parse numbers from text, rejecting values that are not exactly representable
+ *
+ * This header provides parse_exact, which parses the same grammar as `_val` literals and applies
+ * the rules of value-preserving conversions to the exact value denoted by the text. E.g.
+ * `parse_exact<float>("0.25")` succeeds, while `parse_exact<float>("0.1")` fails, because no
+ * float is equal to 1/10.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_PARSE_EXACT_H_
+#define INCLUDE_PARSE_EXACT_H_
+
+#include "value_preserving_cast.h"
+
+#ifdef vir_lib_val_literal
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace vir
+{
+  /**
+   * @brief Reason why parse_exact failed.
+   *
+   * The first three enumerators have the same values as in cast_error.
+   */
+  enum class parse_error : unsigned char
+  {
+    /// The value is outside the range of the target type.
+    out_of_range = 1,
+
+    /// The value is in range but not exactly representable in the target type.
+    inexact,
+
+    /// The value would be subnormal (only with VIR_VAL_REJECT_SUBNORMALS).
+    subnormal,
+
+    /// The text is not a number (or not all of it).
+    invalid_syntax,
+  };
+
+  /**
+   * @brief Result of the bulk parse_exact.
+   *
+   * Mirrors std::from_chars_result: @c error is value-initialized (`parse_error()`) on success.
+   */
+  struct parse_exact_result
+  {
+    /// Pointer to the first character not consumed (the offending token on error).
+    const char* ptr;
+
+    /// Number of values stored.
+    size_t count;
+
+    /// Reason of failure, or `parse_error()` on success.
+    parse_error error;
+  };
+
+  /** @internal
+   * @brief A parsed number: @f$|x| = \_M\_odd \cdot 2^{\_M\_exp}@f$.
+   *
+   * If the value does not have this form with a 64-bit odd factor, _M_error is set to
+   * parse_error::inexact (not a dyadic rational) or _M_wide is set. In both cases _M_top holds a
+   * lower bound of @f$\lfloor\log_2|x|\rfloor@f$.
+   */
+  struct __parsed_number
+  {
+    unsigned long long _M_odd = 0;
+    int _M_exp = 0;
+    bool _M_negative = false;
+    bool _M_wide = false;
+    int _M_top = 0;
+    parse_error _M_error = {};
+  };
+
+  /** @internal
+   * @brief Powers of 5 that fit into 64 bits.
+   */
+  inline constexpr std::array<unsigned long long, 28> __pow5 = [] {
+    std::array<unsigned long long, 28> __r = {1};
+    for (size_t __i = 1; __i < __r.size(); ++__i)
+      __r[__i] = __r[__i - 1] * 5;
+    return __r;
+  }();
+
+  /** @internal
+   * @brief Multiplicative inverses of __pow5 modulo @f$2^{64}@f$.
+   *
+   * @f$d@f$ is divisible by @f$5^m@f$ iff @f$d \cdot 5^{-m} \bmod 2^{64} \le
+   * \lfloor(2^{64}-1)/5^m\rfloor@f$, in which case the product is the quotient.
+   */
+  inline constexpr std::array<unsigned long long, 28> __inv_pow5 = [] {
+    std::array<unsigned long long, 28> __r = {};
+    for (size_t __i = 0; __i < __r.size(); ++__i)
+      {
+        const unsigned long long __a = __pow5[__i];
+        unsigned long long __x = __a; // correct in the lowest 3 bits
+        for (int __k = 0; __k < 5; ++__k)
+          __x *= 2 - __a * __x;
+        __r[__i] = __x;
+      }
+    return __r;
+  }();
+
+  /** @internal
+   * @brief Returns the 8 characters at @p __p as integer (first character in the lowest byte).
+   */
+  constexpr unsigned long long
+  __load8(const char* __p) noexcept
+  {
+    unsigned long long __r = 0;
+    for (int __i = 0; __i < 8; ++__i)
+      __r |= static_cast<unsigned long long>(static_cast<unsigned char>(__p[__i])) << (8 * __i);
+    return __r;
+  }
+
+  /** @internal
+   * @brief Returns the number of leading decimal digits among the 8 characters in @p __v (see
+   * __load8).
+   */
+  constexpr int
+  __count_eight_digits(unsigned long long __v) noexcept
+  {
+    // 0x33 in every byte that holds a digit (carries of the addition only affect bytes after a
+    // non-digit)
+    const unsigned long long __x
+      = ((__v & 0xF0F0F0F0F0F0F0F0) | (((__v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+          ^ 0x3333333333333333;
+    return std::countr_zero(__x) / 8;
+  }
+
+  /** @internal
+   * @brief Returns the value of the 8 decimal digits in @p __v (see __load8).
+   */
+  constexpr unsigned long long
+  __parse_eight_digits(unsigned long long __v) noexcept
+  {
+    __v = (__v & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+    __v = (__v & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+    return (__v & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+  }
+
+  /** @internal
+   * @brief Returns the value of the digit @p __c in base @p __base, or -1.
+   */
+  constexpr int
+  __digit_value(char __c, int __base) noexcept
+  {
+    int __d = -1;
+    if (__c >= '0' && __c <= '9')
+      __d = __c - '0';
+    else if (__c >= 'a' && __c <= 'f')
+      __d = __c - 'a' + 10;
+    else if (__c >= 'A' && __c <= 'F')
+      __d = __c - 'A' + 10;
+    return __d < __base ? __d : -1;
+  }
+
+  /** @internal
+   * @brief Accumulated digits of a digit sequence.
+   */
+  struct __digit_run
+  {
+    /// Value of the digits that fit into 64 bits.
+    unsigned long long _M_value = 0;
+
+    /// Number of digits accumulated into _M_value (including leading zeros).
+    int _M_positions = 0;
+
+    /// Number of digits that did not fit into _M_value anymore.
+    int _M_dropped = 0;
+
+    /// Whether any of the dropped digits is non-zero.
+    bool _M_dropped_nonzero = false;
+  };
+
+  /** @internal
+   * @brief Scan a digit sequence with optional digit separators (`'` between two digits).
+   *
+   * Decimal digits are processed in chunks of up to eight (SWAR) where possible.
+   *
+   * @return Pointer to the first character after the digit sequence.
+   */
+  constexpr const char*
+  __scan_digits(const char* __p, const char* __last, int __base, __digit_run& __run) noexcept
+  {
+    constexpr unsigned long long __max = numeric_limits<unsigned long long>::max();
+    const auto __ubase = static_cast<unsigned long long>(__base);
+    const unsigned long long __max_scalable
+      = __base == 10 ? __max / 10 : __max >> std::countr_zero(unsigned(__base));
+    bool __after_digit = false;
+    while (__p != __last)
+      {
+        if (__base == 10 && __last - __p >= 8 && __run._M_value < 100'000'000'000ull
+              && __run._M_dropped == 0)
+          {
+            constexpr unsigned long long __pow10[]
+              = {1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000};
+            unsigned long long __v = __load8(__p);
+            const int __n = __count_eight_digits(__v);
+            if (__n > 0)
+              {
+                if (__n < 8) // move the digits to the end and prepend '0's
+                  __v = (__v << (8 * (8 - __n))) | (0x3030303030303030 >> (8 * __n));
+                __run._M_value = __run._M_value * __pow10[__n] + __parse_eight_digits(__v);
+                __run._M_positions += __n;
+                __p += __n;
+                __after_digit = true;
+                continue;
+              }
+          }
+        int __d = __digit_value(*__p, __base);
+        if (__d < 0)
+          {
+            if (*__p != '\'' || !__after_digit || __p + 1 == __last
+                  || __digit_value(__p[1], __base) < 0)
+              break;
+            ++__p;
+            __d = __digit_value(*__p, __base);
+          }
+        const auto __ud = static_cast<unsigned long long>(__d);
+        if (__run._M_dropped == 0 && __run._M_value <= __max_scalable
+              && __run._M_value * __ubase <= __max - __ud)
+          {
+            __run._M_value = __run._M_value * __ubase + __ud;
+            ++__run._M_positions;
+          }
+        else
+          {
+            ++__run._M_dropped;
+            __run._M_dropped_nonzero |= __d != 0;
+          }
+        __after_digit = true;
+        ++__p;
+      }
+    return __p;
+  }
+
+  /** @internal
+   * @brief Scan an optionally signed decimal exponent (after 'e' or 'p').
+   *
+   * @return Pointer after the exponent, or @p __p if there is no well-formed exponent.
+   */
+  constexpr const char*
+  __scan_exponent(const char* __p, const char* __last, int& __exp) noexcept
+  {
+    const char* __q = __p;
+    bool __neg = false;
+    if (__q != __last && (*__q == '+' || *__q == '-'))
+      __neg = *__q++ == '-';
+    __digit_run __run;
+    const char* __end = __scan_digits(__q, __last, 10, __run);
+    if (__end == __q)
+      return __p;
+    // saturate: larger exponents cannot produce representable values anyway
+    const int __e = __run._M_dropped != 0 || __run._M_value > 1'000'000
+                      ? 1'000'000 : static_cast<int>(__run._M_value);
+    __exp = __neg ? -__e : __e;
+    return __end;
+  }
+
+  /** @internal
+   * @brief Returns a lower bound of @f$\lfloor\log_2(v \cdot 10^{k_{10}} \cdot 2^{k_2})\rfloor@f$
+   * for @p __v > 0.
+   *
+   * The logarithm of @p __v is computed with 16 fractional bits, truncating every step. Thus
+   * the result is exact unless the value is less than about @f$2^{-16}@f$ (relative) above a
+   * power of two.
+   */
+  constexpr int
+  __log2_lower_bound(unsigned long long __v, int __k10, int __k2) noexcept
+  {
+    const int __w = static_cast<int>(std::bit_width(__v)) - 1;
+    // mantissa in [1, 2) with 31 fractional bits
+    unsigned long long __m = __w >= 31 ? __v >> (__w - 31) : __v << (31 - __w);
+    long long __l = __w;
+    for (int __i = 0; __i < 16; ++__i)
+      {
+        __m = (__m * __m) >> 31;
+        __l <<= 1;
+        if (__m >> 32)
+          {
+            __m >>= 1;
+            __l |= 1;
+          }
+      }
+    // continue with 32 fractional bits; log2(10) = 14267572527.2...p-32
+    __l <<= 16;
+    __l += __k10 >= 0 ? 14267572527ll * __k10 : -14267572528ll * -static_cast<long long>(__k10);
+    __l += static_cast<long long>(__k2) << 32;
+    return static_cast<int>(__l >> 32);
+  }
+
+  /** @internal
+   * @brief Decompose @f$d \cdot 10^k@f$ (@p __d < @f$2^{64}@f$, not divisible by 10) into
+   * @f$\mathrm{odd} \cdot 2^e@f$.
+   */
+  constexpr void
+  __decimal_to_dyadic(unsigned long long __d, int __k, __parsed_number& __r) noexcept
+  {
+    constexpr unsigned long long __max = numeric_limits<unsigned long long>::max();
+    if (__k >= 0)
+      {
+        const int __t = std::countr_zero(__d);
+        const unsigned long long __o = __d >> __t;
+        if (__k >= int(__pow5.size()) || __o > __max / __pow5[size_t(__k)])
+          {
+            __r._M_wide = true;
+            return;
+          }
+        __r._M_odd = __o * __pow5[size_t(__k)];
+        __r._M_exp = __t + __k;
+      }
+    else
+      {
+        const size_t __m = size_t(-__k);
+        const unsigned long long __q = __m < __pow5.size() ? __d * __inv_pow5[__m] : 0;
+        if (__m >= __pow5.size() || __q > __max / __pow5[__m])
+          {
+            __r._M_error = parse_error::inexact;
+            return;
+          }
+        const int __t = std::countr_zero(__q);
+        __r._M_odd = __q >> __t;
+        __r._M_exp = __t + __k;
+      }
+  }
+
+  /** @internal
+   * @brief Decompose a number with more significant digits than fit into 64 bits.
+   *
+   * Slow path using arbitrary-precision arithmetic. The number is the digit sequences
+   * [__int_first, __int_last) "." [__frac_first, __frac_last) (with optional separators) in base
+   * @p __base (10 or 16), times @f$10^{\_\_k}@f$ (decimal) or @f$2^{\_\_k}@f$ (hexadecimal).
+   * Numbers with more than @p __max_digits significant digits are not exactly representable.
+   */
+  constexpr void
+  __wide_to_dyadic(const char* __int_first, const char* __int_last, const char* __frac_first,
+                   const char* __frac_last, int __base, int __k, int __max_digits,
+                   __parsed_number& __r)
+  {
+    std::vector<unsigned char> __digits;
+    for (const char* __p = __int_first; __p != __int_last; ++__p)
+      if (*__p != '\'')
+        __digits.push_back(static_cast<unsigned char>(__digit_value(*__p, __base)));
+    int __scale = 0; // value = digits * base^__scale (times 10^__k or 2^__k)
+    for (const char* __p = __frac_first; __p != __frac_last; ++__p)
+      if (*__p != '\'')
+        {
+          __digits.push_back(static_cast<unsigned char>(__digit_value(*__p, __base)));
+          --__scale;
+        }
+    size_t __b = 0;
+    while (__digits[__b] == 0)
+      ++__b;
+    size_t __e = __digits.size();
+    for (; __digits[__e - 1] == 0; --__e)
+      ++__scale;
+    const int __n = int(__e - __b);
+    int __exp2 = 0;
+    if (__base == 10)
+      __scale += __k;
+    else
+      __exp2 = __k + 4 * __scale;
+    if (__n > __max_digits)
+      {
+        __r._M_wide = true;
+        return;
+      }
+
+    // little-endian limbs of 32 bits
+    std::vector<std::uint32_t> __x = {0};
+    auto __mul_add = [&](std::uint32_t __f, std::uint32_t __a) {
+      std::uint64_t __carry = __a;
+      for (std::uint32_t& __limb : __x)
+        {
+          const std::uint64_t __t = std::uint64_t(__limb) * __f + __carry;
+          __limb = std::uint32_t(__t);
+          __carry = __t >> 32;
+        }
+      if (__carry != 0)
+        __x.push_back(std::uint32_t(__carry));
+    };
+    for (size_t __i = __b; __i < __e; ++__i)
+      __mul_add(std::uint32_t(__base), __digits[__i]);
+
+    if (__base == 10)
+      {
+        if (__scale >= int(__pow5.size()))
+          {
+            __r._M_wide = true;
+            return;
+          }
+        for (int __i = 0; __i < __scale; ++__i)
+          __mul_add(5, 0);
+        for (int __i = 0; __i < -__scale; ++__i)
+          {
+            std::uint64_t __rem = 0;
+            for (size_t __j = __x.size(); __j-- > 0;)
+              {
+                const std::uint64_t __t = (__rem << 32) | __x[__j];
+                __x[__j] = std::uint32_t(__t / 5);
+                __rem = __t % 5;
+              }
+            if (__rem != 0)
+              {
+                __r._M_error = parse_error::inexact;
+                return;
+              }
+          }
+        __exp2 = __scale;
+      }
+    while (__x.back() == 0)
+      __x.pop_back();
+
+    // strip factors of two
+    size_t __zeros = 0;
+    while (__x[__zeros] == 0)
+      ++__zeros;
+    const int __t = std::countr_zero(__x[__zeros]);
+    __exp2 += int(__zeros) * 32 + __t;
+    const int __width = int(__x.size() - __zeros) * 32 - (32 - int(std::bit_width(__x.back())))
+                          - __t;
+    if (__width > 64)
+      {
+        __r._M_wide = true;
+        return;
+      }
+    // at most three limbs remain; shift their concatenation right by __t
+    unsigned long long __lo = __x[__zeros];
+    unsigned long long __hi = 0;
+    if (__zeros + 1 < __x.size())
+      __lo |= std::uint64_t(__x[__zeros + 1]) << 32;
+    if (__zeros + 2 < __x.size())
+      __hi = __x[__zeros + 2];
+    __r._M_odd = __t == 0 ? __lo : (__lo >> __t) | (__hi << (64 - __t));
+    __r._M_exp = __exp2;
+  }
+
+  /** @internal
+   * @brief Parse the longest prefix of [__first, __last) that is a number in the grammar of
+   * `_val` literals, with an optional sign.
+   *
+   * On syntax errors _M_error is set to parse_error::invalid_syntax and @p __first is returned.
+   *
+   * @param __max_digits Passed to __wide_to_dyadic
+   * @return Pointer to the first character after the number
+   */
+  constexpr const char*
+  __scan_number(const char* __first, const char* __last, int __max_digits,
+                __parsed_number& __r)
+  {
+    const char* __p = __first;
+    auto __syntax_error = [&] {
+      __r._M_error = parse_error::invalid_syntax;
+      return __first;
+    };
+    if (__p != __last && (*__p == '-' || *__p == '+'))
+      __r._M_negative = *__p++ == '-';
+    if (__p == __last)
+      return __syntax_error();
+
+    int __base = 10;
+    if (*__p == '0' && __last - __p > 2)
+      {
+        const bool __hex = __p[1] == 'x' || __p[1] == 'X';
+        const bool __bin = __p[1] == 'b' || __p[1] == 'B';
+        if ((__hex && (__digit_value(__p[2], 16) >= 0 || __p[2] == '.'))
+              || (__bin && __digit_value(__p[2], 2) >= 0))
+          {
+            __base = __hex ? 16 : 2;
+            __p += 2;
+          }
+      }
+
+    __digit_run __run;
+    const char* const __int_first = __p;
+    __p = __scan_digits(__p, __last, __base, __run);
+    const char* const __int_last = __p;
+    const int __int_dropped = __run._M_dropped;
+    const char* __frac_first = __p;
+    const char* __frac_last = __p;
+    bool __is_float = false;
+    const int __int_positions = __run._M_positions;
+    if (__base != 2 && __p != __last && *__p == '.')
+      {
+        __frac_first = __p + 1;
+        __frac_last = __scan_digits(__frac_first, __last, __base, __run);
+        if (__frac_last == __frac_first && __int_last == __int_first)
+          return __syntax_error();
+        __p = __frac_last;
+        __is_float = true;
+      }
+    else if (__int_last == __int_first)
+      return __syntax_error();
+    const int __frac_positions = __run._M_positions - __int_positions;
+
+    int __exp = 0;
+    if (__p != __last && (__base == 10 ? (*__p == 'e' || *__p == 'E')
+                                       : __base == 16 && (*__p == 'p' || *__p == 'P')))
+      {
+        const char* __q = __scan_exponent(__p + 1, __last, __exp);
+        if (__q != __p + 1)
+          {
+            __p = __q;
+            __is_float = true;
+          }
+      }
+    if (__base == 16 && __is_float && __p == __frac_last)
+      return __syntax_error(); // hexadecimal floating-point literals require an exponent
+
+    if (!__is_float)
+      {
+        // integer literal: octal if it starts with 0
+        if (__base == 10 && *__int_first == '0' && __int_last - __int_first > 1)
+          {
+            __run = {};
+            if (__scan_digits(__int_first, __int_last, 8, __run) != __int_last)
+              return __syntax_error();
+          }
+        if (__run._M_dropped != 0)
+          // ill-formed as `_val` literal: too large for unsigned long long
+          __r._M_error = parse_error::out_of_range;
+        else if (__run._M_value != 0)
+          {
+            const int __t = std::countr_zero(__run._M_value);
+            __r._M_odd = __run._M_value >> __t;
+            __r._M_exp = __t;
+          }
+        return __p;
+      }
+
+    if (__run._M_dropped_nonzero)
+      __wide_to_dyadic(__int_first, __int_last, __frac_first, __frac_last, __base, __exp,
+                       __max_digits, __r);
+    else if (__run._M_value != 0)
+      {
+        if (__base == 16)
+          {
+            const int __t = std::countr_zero(__run._M_value);
+            __r._M_odd = __run._M_value >> __t;
+            __r._M_exp = __t + __exp + 4 * (__int_dropped - __frac_positions);
+          }
+        else
+          {
+            unsigned long long __d = __run._M_value;
+            int __k = __exp + __int_dropped - __frac_positions;
+            while (__d % 10 == 0)
+              {
+                __d /= 10;
+                ++__k;
+              }
+            __decimal_to_dyadic(__d, __k, __r);
+          }
+      }
+    if (__r._M_error == parse_error::inexact || __r._M_wide)
+      {
+        const int __shift = __int_dropped - __frac_positions;
+        __r._M_top = __base == 16 ? __log2_lower_bound(__run._M_value, 0, __exp + 4 * __shift)
+                                  : __log2_lower_bound(__run._M_value, __exp + __shift, 0);
+      }
+    return __p;
+  }
+
+  /** @internal
+   * @brief Maximal number of significant digits of an exactly representable value of type
+   * @p _Tp (decimal digits of the smallest subnormal plus those of the largest value).
+   */
+  template <__vp_castable _Tp>
+    constexpr int __max_exact_digits
+      = floating_point<_Tp> ? (numeric_limits<_Tp>::digits - numeric_limits<_Tp>::min_exponent)
+                                * 7 / 10 + numeric_limits<_Tp>::max_exponent10 + 2
+                            : numeric_limits<_Tp>::digits10 + 1;
+
+  /** @internal
+   * @brief Returns @p __x times @f$2^{\_\_e}@f$.
+   *
+   * @pre The result is representable (then every intermediate step is exact).
+   */
+  template <floating_point _Tp>
+    constexpr _Tp
+    __scale2(_Tp __x, int __e) noexcept
+    {
+      constexpr _Tp __big = 0x1p60;
+      for (; __e > 60; __e -= 60)
+        __x *= __big;
+      for (; __e < -60; __e += 60)
+        __x /= __big;
+      const _Tp __f = static_cast<_Tp>(1ull << (__e < 0 ? -__e : __e));
+      return __e < 0 ? __x / __f : __x * __f;
+    }
+
+  /** @internal
+   * @brief Convert @p __x to @p _Tp if the value is preserved.
+   */
+  template <__vp_castable _Tp>
+    constexpr std::expected<_Tp, parse_error>
+    __parsed_to(const __parsed_number& __x) noexcept
+    {
+      using _Lp = numeric_limits<_Tp>;
+      // a value that is not preserved is out of range (rather than inexact) if it is at least
+      // 2^__limit in magnitude or negative for an unsigned type (as for value_preserving_cast)
+      constexpr int __limit = integral<_Tp> ? _Lp::digits : _Lp::max_exponent;
+      auto __not_preserved = [&](int __top) {
+        return std::unexpected(__top >= __limit || (__x._M_negative && !_Lp::is_signed)
+                                 ? parse_error::out_of_range : parse_error::inexact);
+      };
+      if (__x._M_error == parse_error::inexact || __x._M_wide)
+        return __not_preserved(__x._M_top);
+      if (__x._M_error != parse_error())
+        return std::unexpected(__x._M_error);
+      if (__x._M_odd == 0)
+        return __x._M_negative ? static_cast<_Tp>(-_Tp()) : _Tp();
+      const int __width = static_cast<int>(std::bit_width(__x._M_odd));
+      if constexpr (integral<_Tp>)
+        {
+          if (__x._M_exp < 0)
+            return __not_preserved(__width - 1 + __x._M_exp);
+          if (__width + __x._M_exp > 64)
+            return std::unexpected(parse_error::out_of_range);
+          const unsigned long long __mag = __x._M_odd << __x._M_exp;
+          if (__x._M_negative)
+            {
+              if (!_Lp::is_signed
+                    || __mag - 1 > static_cast<unsigned long long>(_Lp::max()))
+                return std::unexpected(parse_error::out_of_range);
+              return static_cast<_Tp>(-static_cast<_Tp>(__mag - 1) - 1);
+            }
+          if (__mag > static_cast<unsigned long long>(_Lp::max()))
+            return std::unexpected(parse_error::out_of_range);
+          return static_cast<_Tp>(__mag);
+        }
+      else
+        {
+          const int __top = __width - 1 + __x._M_exp;
+          if (__top >= _Lp::max_exponent)
+            return std::unexpected(parse_error::out_of_range);
+          if (__width > _Lp::digits || __x._M_exp < _Lp::min_exponent - _Lp::digits)
+            return std::unexpected(parse_error::inexact);
+#ifdef VIR_VAL_REJECT_SUBNORMALS
+          if (__top < _Lp::min_exponent - 1)
+            return std::unexpected(parse_error::subnormal);
+#endif
+          const _Tp __v = __scale2(static_cast<_Tp>(__x._M_odd), __x._M_exp);
+          return __x._M_negative ? -__v : __v;
+        }
+    }
+
+  /**
+   * @brief Parse @p __str as number and return its value if it is exactly representable as
+   * @p _Tp.
+   *
+   * The grammar is that of `_val` literals (i.e. C++ integer and floating-point literals without
+   * suffix) with an optional sign: decimal, octal (leading 0), hexadecimal (0x), and binary (0b)
+   * integers, decimal and hexadecimal floating-point numbers, and `'` digit separators. The whole
+   * string must be a number.
+   *
+   * The value is preserved under the rules of the value-preserving conversions: it must be in
+   * range and exactly representable. E.g. "3.0" and "1e3" can be parsed as int, while "0.1"
+   * cannot be parsed as float or double. As for `_val` literals, integers must fit into unsigned
+   * long long. For types with more than 64 mantissa bits, values that need more than 64
+   * significant bits are rejected as inexact.
+   *
+   * Numbers with up to 19 significant digits are decomposed into a dyadic rational without
+   * arbitrary-precision arithmetic, eight digits at a time.
+   *
+   * @code
+   * std::expected<float, vir::parse_error> x = vir::parse_exact<float>("0.125");
+   * @endcode
+   *
+   * @tparam _Tp Target arithmetic type
+   * @param __str The text to parse
+   * @return std::expected<_Tp, parse_error> The value or the reason of failure
+   */
+  template <__vp_castable _Tp>
+    constexpr std::expected<_Tp, parse_error>
+    parse_exact(std::string_view __str)
+    {
+      const char* const __first = __str.data();
+      const char* const __last = __first + __str.size();
+      __parsed_number __x;
+      const char* __end = __scan_number(__first, __last, __max_exact_digits<_Tp>, __x);
+      if (__end != __last)
+        return std::unexpected(parse_error::invalid_syntax);
+      return __parsed_to<_Tp>(__x);
+    }
+
+  /** @internal
+   * @brief Returns whether @p __c separates numbers in the bulk parse_exact.
+   */
+  constexpr bool
+  __is_number_separator(char __c) noexcept
+  { return __c == ' ' || __c == ',' || __c == '\n' || __c == '\t' || __c == '\r'; }
+
+  /**
+   * @brief Parse the numbers in @p __text into @p __out.
+   *
+   * Numbers are separated by whitespace (space, tab, newline, carriage return) and/or commas.
+   * Each number is parsed as by parse_exact(std::string_view). Parsing stops at the first
+   * number that fails (@c ptr points to it and @c error is set), or when @p __out is full
+   * (@c ptr points to the next number, or to the end of @p __text).
+   *
+   * @code
+   * std::vector<std::int16_t> v(n);
+   * auto [ptr, count, error] = vir::parse_exact(text, std::span(v));
+   * @endcode
+   *
+   * @param __text The text to parse
+   * @param __out  Destination of the values
+   * @return parse_exact_result
+   */
+  template <__vp_castable _Tp, size_t _Extent>
+    constexpr parse_exact_result
+    parse_exact(std::string_view __text, std::span<_Tp, _Extent> __out)
+    {
+      const char* __p = __text.data();
+      const char* const __last = __p + __text.size();
+      size_t __count = 0;
+      while (true)
+        {
+          while (__p != __last && __is_number_separator(*__p))
+            ++__p;
+          if (__p == __last || __count == __out.size())
+            return {__p, __count, {}};
+          __parsed_number __x;
+          const char* __end = __scan_number(__p, __last, __max_exact_digits<_Tp>, __x);
+          if (__end == __p || (__end != __last && !__is_number_separator(*__end)))
+            return {__p, __count, parse_error::invalid_syntax};
+          const std::expected<_Tp, parse_error> __v = __parsed_to<_Tp>(__x);
+          if (!__v)
+            return {__p, __count, __v.error()};
+          __out[__count++] = *__v;
+          __p = __end;
+        }
+    }
+}
+
+#endif
+
+#endif  // INCLUDE_PARSE_EXACT_H_
+
+// vim: ft=cpp
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file storage_advisor.h
+ * @brief Determine the narrowest type that preserves every value of a data set
+ *
+ * This header provides storage_advisor, which is fed a data set in pieces (e.g. windows of a
+ * memory-mapped file) and determines which storage types preserve every value, according to the
+ * rules of value_preserving_cast.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_STORAGE_ADVISOR_H_
+#define INCLUDE_STORAGE_ADVISOR_H_
+
+#include "value_preserving_cast.h"
+
+#ifdef vir_lib_val_literal
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace vir
+{
+  /**
+   * @brief Storage types considered by storage_advisor, ordered from narrowest to widest (integers
+   * before floating-point types of the same size).
+   */
+  enum class storage_type : unsigned char
+  {
+    int8, uint8, int16, uint16, int32, uint32, float32, int64, uint64, float64
+  };
+
+  /** @internal
+   * @brief The C++ types corresponding to the storage_type enumerators (in the same order).
+   */
+  using __storage_types = std::tuple<std::int8_t, std::uint8_t, std::int16_t, std::uint16_t,
+                                     std::int32_t, std::uint32_t, float, std::int64_t,
+                                     std::uint64_t, double>;
+
+  /** @internal
+   * @brief Number of storage_type enumerators.
+   */
+  inline constexpr size_t __storage_type_count = std::tuple_size_v<__storage_types>;
+
+  /**
+   * @brief The C++ type corresponding to storage_type @p _St.
+   */
+  template <storage_type _St>
+    using storage_type_t = std::tuple_element_t<size_t(_St), __storage_types>;
+
+  /** @internal
+   * @brief Implementation of visit(storage_type, _Fp&&).
+   */
+  template <size_t _Ip, typename _Fp>
+    constexpr decltype(auto)
+    __visit_storage(storage_type __t, _Fp& __fun)
+    {
+      using _Tp = std::tuple_element_t<_Ip, __storage_types>;
+      if constexpr (_Ip + 1 == __storage_type_count)
+        return __fun(std::type_identity<_Tp>());
+      else if (size_t(__t) == _Ip)
+        return __fun(std::type_identity<_Tp>());
+      else
+        return __visit_storage<_Ip + 1>(__t, __fun);
+    }
+
+  /**
+   * @brief Call @p __fun with `std::type_identity<storage_type_t<__t>>()`.
+   */
+  template <typename _Fp>
+    constexpr decltype(auto)
+    visit(storage_type __t, _Fp&& __fun)
+    { return __visit_storage<0>(__t, __fun); }
+
+  /**
+   * @brief Name of the storage type (e.g. "int16", "float32").
+   */
+  constexpr std::string_view
+  to_string(storage_type __t) noexcept
+  {
+    constexpr std::string_view __names[] = {"int8",  "uint8",  "int16",   "uint16", "int32",
+                                            "uint32", "float32", "int64", "uint64", "float64"};
+    return __names[size_t(__t)];
+  }
+
+  /**
+   * @brief Size of the storage type in bytes.
+   */
+  constexpr size_t
+  size_of(storage_type __t) noexcept
+  { return visit(__t, []<typename _Tp>(std::type_identity<_Tp>) { return sizeof(_Tp); }); }
+
+  /**
+   * @brief Determines the storage types that preserve every value of a data set.
+   *
+   * Call update() for every piece of the data set (in any order), then query narrowest(). Every
+   * candidate storage type is checked with the rules of value_preserving_cast, except that
+   * infinities and NaN are preserved by the floating-point types. They only exclude the integer
+   * types.
+   *
+   * The data is processed in blocks that fit into the L1 cache. Each candidate that has not
+   * failed yet is checked with a vectorizable loop over the block. Candidates are dropped on
+   * their first failure, thus the cost per element typically approaches a single check.
+   *
+   * @code
+   * vir::storage_advisor<double> adv;
+   * for (auto window : windows)
+   *   adv.update(window);
+   * if (auto t = adv.narrowest())
+   *   std::println("{}", vir::to_string(*t));
+   * @endcode
+   *
+   * @tparam _From The type of the values in the data set
+   */
+  template <__vp_castable _From>
+    class storage_advisor
+    {
+      /// Number of elements per block (16 KiB).
+      static constexpr size_t _S_block = 16384 / sizeof(_From);
+
+      /// Bit i is set if storage_type(i) preserved every value so far.
+      std::uint16_t _M_candidates = (1u << __storage_type_count) - 1;
+
+      /// Returns whether every element of @p __in[0:__n] is preserved by _To.
+      template <typename _To>
+        static constexpr bool
+        _S_lossless(const _From* __in, size_t __n) noexcept
+        {
+          unsigned char __err = 0;
+          for (size_t __i = 0; __i < __n; ++__i)
+            {
+              const unsigned char __e = __vp_convert<_To>(__in[__i])._M_error;
+              if constexpr (floating_point<_From> && floating_point<_To>)
+                {
+                  // infinities and NaN convert to _To unchanged
+                  const _From __x = __in[__i];
+                  const bool __finite = (__x < 0 ? -__x : __x) <= numeric_limits<_From>::max();
+                  __err |= __finite ? __e : 0;
+                }
+              else
+                __err |= __e;
+            }
+          return __err == 0;
+        }
+
+    public:
+      /**
+       * @brief Check the values in @p __data.
+       */
+      constexpr void
+      update(std::span<const _From> __data) noexcept
+      {
+        for (size_t __i = 0; __i < __data.size() && _M_candidates != 0; __i += _S_block)
+          {
+            const _From* __block = __data.data() + __i;
+            const size_t __n = std::min(_S_block, __data.size() - __i);
+            [&]<size_t... _Is>(std::index_sequence<_Is...>) {
+              ([&] {
+                constexpr auto __bit = std::uint16_t(1u << _Is);
+                if ((_M_candidates & __bit) != 0
+                      && !_S_lossless<std::tuple_element_t<_Is, __storage_types>>(__block, __n))
+                  _M_candidates &= std::uint16_t(~__bit);
+              }(), ...);
+            }(std::make_index_sequence<__storage_type_count>());
+          }
+      }
+
+      /**
+       * @brief Returns whether @p __t preserved every value checked so far.
+       */
+      constexpr bool
+      preserves(storage_type __t) const noexcept
+      { return (_M_candidates >> size_t(__t)) & 1u; }
+
+      /**
+       * @brief Returns the narrowest type that preserved every value checked so far, or nothing
+       * if no storage type did (e.g. for long double values beyond the range of double).
+       */
+      constexpr std::optional<storage_type>
+      narrowest() const noexcept
+      {
+        if (_M_candidates == 0)
+          return std::nullopt;
+        return storage_type(std::countr_zero(_M_candidates));
+      }
+    };
+}
+
+#endif
+
+#endif  // INCLUDE_STORAGE_ADVISOR_H_
+
+// vim: ft=cpp
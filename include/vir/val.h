@@ -18,11 +18,19 @@
 #if __cpp_concepts >= 202002L && __cpp_deleted_function >= 202403L \
                       && __cpp_constexpr_exceptions >= 202411L
 
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <limits>
+#include <numeric>
+#include <ratio>
 #include <source_location>
+#include <stdexcept>
 #include <string_view>
+#include <type_traits>
 
 /**
  * @brief Feature macro for value-preserving literals.
@@ -31,6 +39,18 @@
  */
 #define vir_lib_val_literal 202601L
 
+#ifdef DOXYGEN
+/**
+ * @brief Opt-in: reject conversions to floating-point types that produce a subnormal value.
+ *
+ * Define this macro before including val.h to make every conversion of constreal and
+ * constrounded throw bad_value_preserving_cast if the result is subnormal (denormal) in the target
+ * type. Arithmetic with subnormals is very slow on many CPUs (unless FTZ/DAZ is enabled). For
+ * applying the check only at selected use sites see vir::no_subnormal.
+ */
+#define VIR_VAL_REJECT_SUBNORMALS
+#endif
+
 /**
  * @namespace vir
  *
@@ -47,6 +67,7 @@ namespace vir
   using std::type_identity_t;
   using std::numeric_limits;
   using std::u8string_view;
+  using std::size_t;
 
   /** @internal
    * @brief Concept for arithmetic types
@@ -56,10 +77,34 @@ namespace vir
   template <typename _Tp>
     concept __arithmetic = integral<_Tp> || floating_point<_Tp>;
 
+  /** @internal
+   * @brief The element type of @p _Vp (arithmetic types and data-parallel types).
+   */
+  template <typename _Vp>
+    struct __value_type
+    {};
+
+  template <typename _Vp>
+    requires requires { typename _Vp::value_type; }
+    struct __value_type<_Vp>
+    { using type = typename _Vp::value_type; };
+
+  template <__arithmetic _Vp>
+    struct __value_type<_Vp>
+    { using type = _Vp; };
+
+  template <typename _Vp>
+    using __value_type_t = typename __value_type<_Vp>::type;
+
   struct constinteger;
 
   struct constreal;
 
+  struct constrational;
+
+  template <typename _Policy, typename _Cp>
+    struct constrounded;
+
   /**
    * @brief Exception thrown when conversion to arithmetic type would change value.
    *
@@ -129,6 +174,67 @@ namespace vir
     consteval source_location where() const noexcept { return _M_where; }
   };
 
+  /**
+   * @brief Exception thrown when a table element cannot be converted value-preserving.
+   *
+   * Thrown by table() and tabulate(). In addition to the information stored in
+   * bad_value_preserving_cast it identifies the offending element.
+   */
+  class bad_table_element_cast : public bad_value_preserving_cast
+  {
+  private:
+    /// Index of the element that failed to convert
+    size_t _M_index;
+
+  public:
+    /**
+     * @brief Construct with element index and source location
+     *
+     * @param __index Index of the element that failed to convert
+     * @param __where Source location where the conversion failed
+     */
+    consteval
+    bad_table_element_cast(size_t __index,
+                           source_location __where = source_location::current()) noexcept
+    : bad_value_preserving_cast(__where), _M_index(__index) {}
+
+    /// Defaulted copy constructor
+    consteval bad_table_element_cast(const bad_table_element_cast&) = default;
+    /// Defaulted move constructor
+    consteval bad_table_element_cast(bad_table_element_cast&&) = default;
+
+    /// Defaulted copy assignment
+    consteval bad_table_element_cast& operator=(const bad_table_element_cast&) = default;
+    /// Defaulted move assignment
+    consteval bad_table_element_cast& operator=(bad_table_element_cast&&) = default;
+
+    /**
+     * @brief Get the index of the element that failed to convert
+     *
+     * @return size_t Index into the table
+     */
+    consteval size_t index() const noexcept { return _M_index; }
+  };
+
+  /** @internal
+   * @brief Throws bad_value_preserving_cast if @p __x is subnormal.
+   */
+  template <floating_point _Tp>
+    consteval void
+    __reject_subnormal(_Tp __x)
+    {
+      if (__x != 0 && __x < numeric_limits<_Tp>::min() && __x > -numeric_limits<_Tp>::min())
+        throw bad_value_preserving_cast();
+    }
+
+  /** @internal
+   * @brief Returns -1 / 1 if @p __x is below / above the range of the integral type @p _Tp, 0
+   * otherwise (also for floating-point @p _Tp).
+   */
+  template <__arithmetic _Tp>
+    consteval int
+    __range_order(const constinteger& __x) noexcept;
+
   /** @internal
    * @brief binary operators, compound assignment, and comparison operators for constinteger and
    * constreal
@@ -166,6 +272,78 @@ namespace vir
         _ConvertTo(const constreal& __x)
         : _M_value(__x)
         {}
+
+        /** @internal
+         * @brief Convert from constrational @p __x to arithmetic type _Tp.
+         */
+        consteval
+        _ConvertTo(const constrational& __x)
+        : _M_value(__x)
+        {}
+
+        /** @internal
+         * @brief Convert from constrounded @p __x to arithmetic type _Tp.
+         */
+        template <typename _Policy, typename _Cp>
+          consteval
+          _ConvertTo(const constrounded<_Policy, _Cp>& __x)
+          : _M_value(__x)
+          {}
+      };
+
+    /** @internal
+     * @brief Conversion wrapper for comparison operators.
+     *
+     * Like _ConvertTo, except that constintegers outside the range of an integral type @p _Tp are
+     * not an error but recorded in _M_order.
+     *
+     * @tparam _Tp Target arithmetic type
+     */
+    template <__arithmetic _Tp>
+      struct _CompareTo
+      {
+        /// @internal The converted value (zero if _M_order is not zero)
+        _Tp _M_value = 0;
+
+        /// @internal -1 / 1 if the constant is below / above the range of _Tp, 0 otherwise
+        int _M_order = 0;
+
+        /** @internal
+         * @brief Convert from constinteger @p __x to arithmetic type _Tp or determine that it is
+         * out of range.
+         */
+        consteval
+        _CompareTo(const constinteger& __x)
+        : _M_order(__range_order<_Tp>(__x))
+        {
+          if (_M_order == 0)
+            _M_value = __x;
+        }
+
+        /** @internal
+         * @brief Convert from constreal @p __x to arithmetic type _Tp.
+         */
+        consteval
+        _CompareTo(const constreal& __x)
+        : _M_value(__x)
+        {}
+
+        /** @internal
+         * @brief Convert from constrational @p __x to arithmetic type _Tp.
+         */
+        consteval
+        _CompareTo(const constrational& __x)
+        : _M_value(__x)
+        {}
+
+        /** @internal
+         * @brief Convert from constrounded @p __x to arithmetic type _Tp.
+         */
+        template <typename _Policy, typename _Cp>
+          consteval
+          _CompareTo(const constrounded<_Policy, _Cp>& __x)
+          : _M_value(__x)
+          {}
       };
 
     /** @internal
@@ -175,7 +353,7 @@ namespace vir
     template <constraint _Tp>                                                                      \
       friend constexpr _Tp&                                                                        \
       operator op##=(_Tp& __a, _ConvertTo<type_identity_t<_Tp>> __b) noexcept                      \
-      { return __a += __b._M_value; }                                                              \
+      { return __a op##= __b._M_value; }                                                           \
                                                                                                    \
     template <constraint _Tp>                                                                      \
       friend constexpr _Tp                                                                         \
@@ -200,17 +378,22 @@ namespace vir
 
     /** @internal
      * @brief Comparison operators.
+     *
+     * Comparisons of integral values with constintegers are range-aware: if the constant is
+     * outside the range of the integral type, the result is known at compile time (e.g.
+     * `int8_t(x) < 1000_val` and `unsigned(x) > -1_val` are true). Otherwise, the comparison is
+     * done in the integral type.
      */
 #define _GLIBCXX_CONVERTTO_CMP(op)                                                                 \
     template <__arithmetic _Tp>                                                                    \
       friend constexpr bool                                                                        \
-      operator op(_Tp __a, _ConvertTo<type_identity_t<_Tp>> __b) noexcept                          \
-      { return __a op __b._M_value; }                                                              \
+      operator op(_Tp __a, _CompareTo<type_identity_t<_Tp>> __b) noexcept                          \
+      { return __b._M_order == 0 ? __a op __b._M_value : 0 op __b._M_order; }                       \
                                                                                                    \
     template <__arithmetic _Tp>                                                                    \
       friend constexpr bool                                                                        \
-      operator op(_ConvertTo<type_identity_t<_Tp>> __a, _Tp __b) noexcept                          \
-      { return __a._M_value op __b; }
+      operator op(_CompareTo<type_identity_t<_Tp>> __a, _Tp __b) noexcept                          \
+      { return __a._M_order == 0 ? __a._M_value op __b : __a._M_order op 0; }
 
     _GLIBCXX_CONVERTTO_CMP(==)
     _GLIBCXX_CONVERTTO_CMP(!=)
@@ -307,6 +490,21 @@ namespace vir
       }
   };
 
+  template <__arithmetic _Tp>
+    consteval int
+    __range_order(const constinteger& __x) noexcept
+    {
+      using L = numeric_limits<_Tp>;
+      if constexpr (integral<_Tp>)
+        {
+          if (__x._M_negative && __x._M_value > -static_cast<unsigned long long>(L::lowest()))
+            return -1;
+          else if (!__x._M_negative && __x._M_value > L::max())
+            return 1;
+        }
+      return 0;
+    }
+
   /**
    * @brief User-defined literal for untyped constants.
    *
@@ -349,6 +547,9 @@ namespace vir
    *
    * Represents a real value with up to the precision of long double.
    *
+   * Results of the consteval functions in val_math.h (e.g. vir::sqrt) additionally carry the
+   * difference to the exact result, which identifies them as not representable as long double.
+   *
    * Conversions to arithmetic types are only allowed when they are value-preserving.
    * Otherwise, bad_value_preserving_cast is thrown.
    */
@@ -357,6 +558,9 @@ namespace vir
     /// @internal The real value stored as long double
     long double _M_value;
 
+    /// @internal The exact value minus _M_value (zero if _M_value is exact)
+    long double _M_residual = 0;
+
     /**
      * @brief Unary negation operator
      *
@@ -365,7 +569,7 @@ namespace vir
      */
     friend consteval constreal
     operator-(constreal __v) noexcept
-    { return constreal{{}, -__v._M_value}; }
+    { return constreal{{}, -__v._M_value, -__v._M_residual}; }
 
     /**
      * @brief Unary plus operator (identity)
@@ -400,10 +604,16 @@ namespace vir
       operator _Up() const
       {
         using L = numeric_limits<_Up>;
+        if (_M_residual != 0)
+          throw bad_value_preserving_cast();
         if (_M_value > L::max() || _M_value < L::lowest())
           throw bad_value_preserving_cast();
         if (static_cast<long double>(static_cast<_Up>(_M_value)) != _M_value)
           throw bad_value_preserving_cast();
+#ifdef VIR_VAL_REJECT_SUBNORMALS
+        if constexpr (floating_point<_Up>)
+          __reject_subnormal(static_cast<_Up>(_M_value));
+#endif
         return static_cast<_Up>(_M_value);
       }
   };
@@ -411,7 +621,9 @@ namespace vir
   /**
    * @brief User-defined literal for untyped constants
    *
-   * Creates a constreal from a literal interpreted as long double.
+   * Creates a constreal from a literal interpreted as long double. The compiler rounds the
+   * literal to long double before this operator sees it, so that the constant is the long double
+   * value of the literal (and conversion policies round that value, not the decimal literal).
    *
    * @param __x The literal value
    * @return constreal Value-preserving real constant
@@ -429,6 +641,1310 @@ namespace vir
   consteval constreal
   val(long double __x) noexcept
   { return constreal{{}, __x}; }
+
+  /** @internal
+   * @brief Returns the exponent of @p __x, i.e. @f$\lfloor\log_2|x|\rfloor@f$.
+   *
+   * @pre @p __x is finite and positive.
+   */
+  consteval int
+  __ilogb(long double __x) noexcept
+  {
+    int __e = 0;
+    for (; __x >= 0x1p64L; __e += 64)
+      __x *= 0x1p-64L;
+    for (; __x < 0x1p-64L; __e -= 64)
+      __x *= 0x1p64L;
+    for (; __x >= 2; ++__e)
+      __x /= 2;
+    for (; __x < 1; --__e)
+      __x *= 2;
+    return __e;
+  }
+
+  /** @internal
+   * @brief Returns @f$x\cdot2^n@f$.
+   *
+   * Exact whenever the result is representable.
+   */
+  consteval long double
+  __scalbn(long double __x, int __n) noexcept
+  {
+    for (; __n >= 64; __n -= 64)
+      __x *= 0x1p64L;
+    for (; __n <= -64; __n += 64)
+      __x *= 0x1p-64L;
+    for (; __n > 0; --__n)
+      __x *= 2;
+    for (; __n < 0; ++__n)
+      __x /= 2;
+    return __x;
+  }
+
+  /** @internal
+   * @brief Returns @p __x rounded toward zero to an integral value.
+   *
+   * @pre 0 <= @p __x < 2^(digits of long double - 1)
+   */
+  consteval long double
+  __trunc(long double __x) noexcept
+  {
+    constexpr long double __c = __scalbn(1.L, numeric_limits<long double>::digits - 1);
+    const long double __r = (__x + __c) - __c;
+    return __r > __x ? __r - 1 : __r;
+  }
+
+  /** @internal
+   * @brief The two values of type @p _Up enclosing a non-negative real value.
+   *
+   * If the value is representable, both members are equal to it.
+   */
+  template <floating_point _Up>
+    struct __neighbors
+    {
+      /// The largest value of type _Up that is less than or equal to the real value
+      _Up _M_down;
+
+      /// The smallest value of type _Up that is greater than or equal to the real value
+      _Up _M_up;
+
+      /// Negative, zero, or positive if the real value is below, at, or above the midpoint
+      int _M_half = 0;
+
+      /// Whether _M_down has an even significand (for ties-to-even)
+      bool _M_down_even = true;
+
+      consteval bool
+      _M_exact() const noexcept
+      { return _M_down == _M_up; }
+    };
+
+  /** @internal
+   * @brief Determine the neighbors of @p __x in @p _Up.
+   *
+   * If @p __digits is less than the number of significand digits of @p _Up, the neighbors are
+   * restricted to values of @p _Up with at most @p __digits significant digits.
+   *
+   * @throws bad_value_preserving_cast if @p __x is not finite or larger than the largest finite
+   * value of @p _Up.
+   */
+  template <floating_point _Up>
+    consteval __neighbors<_Up>
+    __neighbors_of(long double __x, int __digits = numeric_limits<_Up>::digits)
+    {
+      using L = numeric_limits<_Up>;
+      if (!(__x >= 0 && __x <= L::max()))
+        throw bad_value_preserving_cast();
+      if (__digits >= L::digits)
+        {
+          const _Up __r = static_cast<_Up>(__x);
+          if (static_cast<long double>(__r) == __x)
+            return {__r, __r};
+        }
+      if (__x == 0)
+        return {0, 0};
+      // ulp of _Up at the magnitude of __x (subnormals have the ulp of the smallest normal value)
+      const int __ulp_exp = (__ilogb(__x) < L::min_exponent - 1 ? L::min_exponent - 1
+                                                                  : __ilogb(__x)) - __digits + 1;
+      const long double __m = __scalbn(__x, -__ulp_exp);
+      const long double __t = __trunc(__m);
+      const long double __frac = __m - __t;
+      if (__frac == 0)
+        {
+          const _Up __r = static_cast<_Up>(__x);
+          return {__r, __r};
+        }
+      return {static_cast<_Up>(__scalbn(__t, __ulp_exp)),
+              static_cast<_Up>(__scalbn(__t + 1, __ulp_exp)),
+              __frac < .5L ? -1 : __frac > .5L ? 1 : 0,
+              __trunc(__t / 2) * 2 == __t};
+    }
+
+  /** @internal
+   * @copydoc __neighbors_of(long double)
+   */
+  template <floating_point _Up>
+    consteval __neighbors<_Up>
+    __neighbors_of(unsigned long long __x)
+    {
+      using L = numeric_limits<_Up>;
+      int __width = 0;
+      for (unsigned long long __y = __x; __y != 0; __y >>= 1)
+        ++__width;
+      if (__width <= L::digits)
+        {
+          const _Up __r = static_cast<_Up>(__x);
+          return {__r, __r};
+        }
+      if (__width > L::max_exponent)
+        throw bad_value_preserving_cast();
+      const int __shift = __width - L::digits;
+      const unsigned long long __ulp = 1ull << __shift;
+      const unsigned long long __t = __x >> __shift;
+      const unsigned long long __rem = __x & (__ulp - 1);
+      const _Up __down = static_cast<_Up>(__t << __shift);
+      if (__rem == 0)
+        return {__down, __down};
+      if (__down == L::max())
+        throw bad_value_preserving_cast();
+      // __t + 1 may need one more bit than unsigned long long has, but is exact in _Up
+      const _Up __up = __down + static_cast<_Up>(__ulp);
+      const unsigned long long __half = __ulp >> 1;
+      return {__down, __up, __rem < __half ? -1 : __rem > __half ? 1 : 0, __t % 2 == 0};
+    }
+
+  /** @internal
+   * @brief Returns the neighbor of the non-negative value @p __r of type @p _Up in direction
+   * @p __dir (+1: up, -1: down).
+   *
+   * @pre @p __r is positive if @p __dir is negative.
+   */
+  template <floating_point _Up>
+    consteval _Up
+    __next_after(_Up __r, int __dir)
+    {
+      using L = numeric_limits<_Up>;
+      if (__r == 0)
+        return L::denorm_min();
+      if (__dir > 0 && __r == L::max())
+        throw bad_value_preserving_cast();
+      int __e = __ilogb(__r);
+      if (__dir < 0 && __scalbn(1.L, __e) == __r)
+        --__e; // the distance to the next smaller value is half as large
+      const int __ulp_exp = (__e < L::min_exponent - 1 ? L::min_exponent - 1 : __e) - L::digits + 1;
+      return static_cast<_Up>(__r + __dir * __scalbn(1.L, __ulp_exp));
+    }
+
+  /** @internal
+   * @brief Adjust the neighbors of a value when the exact value is slightly above (@p __dir > 0)
+   * or below (@p __dir < 0).
+   */
+  template <floating_point _Up>
+    consteval __neighbors<_Up>
+    __with_residual(const __neighbors<_Up>& __n, int __dir)
+    {
+      if (!__n._M_exact())
+        return {__n._M_down, __n._M_up, __n._M_half == 0 ? __dir : __n._M_half,
+                __n._M_down_even};
+      else if (__dir > 0)
+        return {__n._M_down, __next_after(__n._M_down, 1), -1};
+      else
+        return {__next_after(__n._M_up, -1), __n._M_up, 1};
+    }
+
+  /** @internal
+   * @brief Returns the value of @p __x as constreal, with a residual if it is not representable
+   * as long double.
+   */
+  consteval constreal
+  __to_real(const constrational& __x);
+
+  /**
+   * @brief Untyped rational constant.
+   *
+   * Represents the exact quotient of two untyped integer constants, e.g. `1_val / 3_val`.
+   * Numerator and denominator are stored in lowest terms with the precision of unsigned long long.
+   *
+   * Conversions to integral types are only allowed if the denominator is 1. Conversions to
+   * floating-point types are only allowed if the value is representable. Otherwise,
+   * bad_value_preserving_cast is thrown. Use val(x, policy) to declare the rounding that is
+   * acceptable:
+   *
+   * @code
+   * constexpr auto third = vir::val(1_val / 3_val, vir::round_to_nearest);
+   *
+   * auto f(std::floating_point auto x)
+   * { return x * third; } // multiplication instead of division by 3
+   * @endcode
+   */
+  struct constrational : _ConstBinaryOps
+  {
+    /// @internal The numerator of the absolute value
+    unsigned long long _M_num;
+
+    /// @internal The denominator (positive and coprime to _M_num)
+    unsigned long long _M_den = 1;
+
+    /// @internal Flag indicating if the value is negative
+    bool _M_negative = false;
+
+    /**
+     * @brief Unary negation operator
+     */
+    friend consteval constrational
+    operator-(constrational __v) noexcept
+    { return constrational{{}, __v._M_num, __v._M_den, !__v._M_negative}; }
+
+    /**
+     * @brief Unary plus operator (identity)
+     */
+    friend consteval constrational
+    operator+(constrational __v) noexcept
+    { return __v; }
+
+    /**
+     * @brief Bitwise complement operator (deleted)
+     */
+    friend consteval constrational
+    operator~(constrational) = delete;
+
+    /**
+     * @brief Logical NOT operator (deleted)
+     *
+     * Explicitly write 1 or 0 instead.
+     */
+    friend consteval constrational
+    operator!(constrational) = delete("explicitly write 1 or 0 instead");
+
+    /**
+     * @copydoc constinteger::operator _Up()
+     */
+    template <__arithmetic _Up>
+      consteval
+      operator _Up() const
+      {
+        if constexpr (floating_point<_Up>)
+          return __to_real(*this);
+        else if (_M_den != 1)
+          throw bad_value_preserving_cast();
+        else
+          return constinteger{{}, _M_num, _M_negative};
+      }
+  };
+
+  consteval constreal
+  __to_real(const constrational& __x)
+  {
+    constexpr int __digits = numeric_limits<long double>::digits < 64
+                               ? numeric_limits<long double>::digits : 64;
+    const unsigned long long __den = __x._M_den;
+    const unsigned long long __q = __x._M_num / __den;
+    unsigned long long __rem = __x._M_num % __den;
+    // |x| = (__m + __frac) * 2^__e with 0 <= __frac < 1; round __m to nearest and keep the
+    // difference as residual
+    const int __width = static_cast<int>(std::bit_width(__q));
+    int __e = __width > __digits ? __width - __digits : 0;
+    unsigned long long __m = __q >> __e;
+    bool __up = false;
+    long double __frac = 0;
+    if (__e > 0)
+      {
+        const unsigned long long __lost = __q & ((1ull << __e) - 1);
+        const unsigned long long __half = 1ull << (__e - 1);
+        __up = __lost > __half || (__lost == __half && (__rem != 0 || __m % 2 == 1));
+        __frac = __scalbn(static_cast<long double>(__lost)
+                            + static_cast<long double>(__rem) / static_cast<long double>(__den),
+                          -__e);
+      }
+    else
+      {
+        for (; __rem != 0 && static_cast<int>(std::bit_width(__m)) < __digits; --__e)
+          {
+            // next binary digit of __rem / __den, without overflowing 2 * __rem
+            const bool __bit = __rem >= __den - __rem;
+            __rem = __bit ? __rem - (__den - __rem) : 2 * __rem;
+            __m = 2 * __m + __bit;
+          }
+        // ties to even; a tie (__rem / __den == 1/2) is only possible if long double has fewer
+        // than 64 digits, e.g. (2^53 + 1) / 4 with 53 digits
+        __up = __rem != 0 && (__rem > __den - __rem || (__rem == __den - __rem && __m % 2 == 1));
+        __frac = static_cast<long double>(__rem) / static_cast<long double>(__den);
+      }
+    const long double __v = __scalbn(static_cast<long double>(__m) + __up, __e);
+    const long double __residual = __scalbn(__frac - __up, __e);
+    return __x._M_negative ? constreal{{}, -__v, -__residual} : constreal{{}, __v, __residual};
+  }
+
+  /** @internal
+   * @brief Concept for untyped constants with an exact rational value.
+   */
+  template <typename _Tp>
+    concept __exact_constant = std::same_as<_Tp, constinteger> || std::same_as<_Tp, constrational>;
+
+  /** @internal
+   * @brief Returns @p __x as constrational.
+   */
+  consteval constrational
+  __to_rational(const constinteger& __x) noexcept
+  { return {{}, __x._M_value, 1, __x._M_negative}; }
+
+  /** @internal
+   * @copydoc __to_rational(const constinteger&)
+   */
+  consteval constrational
+  __to_rational(const constrational& __x) noexcept
+  { return __x; }
+
+  /** @internal
+   * @brief Returns @p __a * @p __b.
+   *
+   * @throws bad_value_preserving_cast if the product does not fit into unsigned long long.
+   */
+  consteval unsigned long long
+  __checked_mul(unsigned long long __a, unsigned long long __b)
+  {
+    if (__b != 0 && __a > numeric_limits<unsigned long long>::max() / __b)
+      throw bad_value_preserving_cast();
+    return __a * __b;
+  }
+
+  /**
+   * @brief Exact division of untyped integer or rational constants.
+   *
+   * @return constrational The quotient in lowest terms
+   * @throws std::domain_error if @p __b is zero
+   * @throws bad_value_preserving_cast if numerator or denominator of the quotient do not fit into
+   * unsigned long long
+   */
+  template <__exact_constant _Tp, __exact_constant _Up>
+    consteval constrational
+    operator/(const _Tp& __a, const _Up& __b)
+    {
+      const constrational __x = __to_rational(__a);
+      const constrational __y = __to_rational(__b);
+      if (__y._M_num == 0)
+        throw std::domain_error("vir: division by zero");
+      // (n0/d0) / (n1/d1) = (n0 * d1) / (d0 * n1), reduced before multiplication
+      const unsigned long long __g0 = std::gcd(__x._M_num, __y._M_num);
+      const unsigned long long __g1 = std::gcd(__x._M_den, __y._M_den);
+      return {{}, __checked_mul(__x._M_num / __g0, __y._M_den / __g1),
+              __checked_mul(__x._M_den / __g1, __y._M_num / __g0),
+              __x._M_negative != __y._M_negative};
+    }
+
+  /** @internal
+   * @brief Returns the constinteger with magnitude @p __abs and sign @p __negative (zero is never
+   * negative).
+   */
+  consteval constinteger
+  __make_constinteger(unsigned long long __abs, bool __negative) noexcept
+  { return {{}, __abs, __negative && __abs != 0}; }
+
+  /**
+   * @brief Exact addition of untyped integer constants.
+   *
+   * @throws bad_value_preserving_cast if the magnitude of the sum does not fit into unsigned long
+   * long
+   */
+  consteval constinteger
+  operator+(const constinteger& __a, const constinteger& __b)
+  {
+    if (__a._M_negative == __b._M_negative)
+      {
+        if (__b._M_value > numeric_limits<unsigned long long>::max() - __a._M_value)
+          throw bad_value_preserving_cast();
+        return __make_constinteger(__a._M_value + __b._M_value, __a._M_negative);
+      }
+    else if (__a._M_value >= __b._M_value)
+      return __make_constinteger(__a._M_value - __b._M_value, __a._M_negative);
+    else
+      return __make_constinteger(__b._M_value - __a._M_value, __b._M_negative);
+  }
+
+  /**
+   * @brief Exact subtraction of untyped integer constants.
+   *
+   * @throws bad_value_preserving_cast if the magnitude of the difference does not fit into
+   * unsigned long long
+   */
+  consteval constinteger
+  operator-(const constinteger& __a, const constinteger& __b)
+  { return __a + -__b; }
+
+  /**
+   * @brief Exact multiplication of untyped integer constants.
+   *
+   * @throws bad_value_preserving_cast if the magnitude of the product does not fit into unsigned
+   * long long
+   */
+  consteval constinteger
+  operator*(const constinteger& __a, const constinteger& __b)
+  {
+    return __make_constinteger(__checked_mul(__a._M_value, __b._M_value),
+                               __a._M_negative != __b._M_negative);
+  }
+
+  /** @internal
+   * @brief Three-way comparison of the exact values of @p __a and @p __b.
+   *
+   * @return int -1, 0, or 1 if @p __a is less than, equal to, or greater than @p __b
+   */
+  template <__exact_constant _Tp, __exact_constant _Up>
+    consteval int
+    __compare(const _Tp& __a, const _Up& __b) noexcept
+    {
+      const constrational __x = __to_rational(__a);
+      const constrational __y = __to_rational(__b);
+      const bool __xneg = __x._M_negative && __x._M_num != 0;
+      const bool __yneg = __y._M_negative && __y._M_num != 0;
+      if (__xneg != __yneg)
+        return __xneg ? -1 : 1;
+      // compare the magnitudes n0/d0 and n1/d1 via their continued fractions
+      unsigned long long __n0 = __x._M_num, __d0 = __x._M_den;
+      unsigned long long __n1 = __y._M_num, __d1 = __y._M_den;
+      int __r = 0;
+      for (bool __flip = false;; __flip = !__flip)
+        {
+          const unsigned long long __q0 = __n0 / __d0;
+          const unsigned long long __q1 = __n1 / __d1;
+          const unsigned long long __r0 = __n0 % __d0;
+          const unsigned long long __r1 = __n1 % __d1;
+          if (__q0 != __q1)
+            __r = __q0 < __q1 ? -1 : 1;
+          else if (__r0 == 0 || __r1 == 0)
+            __r = int(__r0 != 0) - int(__r1 != 0);
+          else
+            {
+              // n0/d0 < n1/d1 <=> r0/d0 < r1/d1 <=> d0/r0 > d1/r1
+              __n0 = __d0;
+              __d0 = __r0;
+              __n1 = __d1;
+              __d1 = __r1;
+              continue;
+            }
+          if (__flip)
+            __r = -__r;
+          break;
+        }
+      return __xneg ? -__r : __r;
+    }
+
+  /**
+   * @brief Create untyped constant from std::ratio.
+   *
+   * @return constrational Value-preserving rational constant
+   */
+  template <std::intmax_t _Num, std::intmax_t _Den>
+    consteval constrational
+    val(std::ratio<_Num, _Den>) noexcept
+    {
+      using _Rp = std::ratio<_Num, _Den>;
+      if constexpr (_Rp::num < 0)
+        return {{}, -static_cast<unsigned long long>(_Rp::num),
+                static_cast<unsigned long long>(_Rp::den), true};
+      else
+        return {{}, static_cast<unsigned long long>(_Rp::num),
+                static_cast<unsigned long long>(_Rp::den)};
+    }
+
+  /** @internal
+   * @brief Returns the signed numerator of @p __x as std::intmax_t.
+   *
+   * @throws bad_value_preserving_cast if it is not representable.
+   */
+  consteval std::intmax_t
+  __ratio_num(const constrational& __x)
+  { return constinteger{{}, __x._M_num, __x._M_negative}; }
+
+  /** @internal
+   * @brief Returns the denominator of @p __x as std::intmax_t.
+   *
+   * @throws bad_value_preserving_cast if it is not representable.
+   */
+  consteval std::intmax_t
+  __ratio_den(const constrational& __x)
+  { return constinteger{{}, __x._M_den}; }
+
+  /**
+   * @brief The std::ratio specialization with the value of @p _Rp.
+   *
+   * @code
+   * static_assert(std::same_as<vir::to_ratio<1_val / 3_val>, std::ratio<1, 3>>);
+   * @endcode
+   */
+  template <constrational _Rp>
+    using to_ratio = std::ratio<__ratio_num(_Rp), __ratio_den(_Rp)>;
+
+  /**
+   * @brief Conversion policy: value-preserving conversion.
+   *
+   * This is the semantics of the implicit conversions of constinteger and constreal: if the value
+   * is not representable in the target type, bad_value_preserving_cast is thrown.
+   */
+  struct exact_t
+  {
+    /** @internal
+     * @brief Select the result for the real value @p __x with magnitude enclosed by @p __n.
+     */
+    template <floating_point _Up>
+      static consteval _Up
+      _S_select(const __neighbors<_Up>& __n, long double, bool)
+      {
+        if (!__n._M_exact())
+          throw bad_value_preserving_cast();
+        return __n._M_down;
+      }
+  };
+
+  /**
+   * @brief Conversion policy: rounding in the given rounding direction.
+   *
+   * The value of the constant is correctly rounded to the target type. For integer and rational
+   * constants that is their exact value. For floating-point literals it is the long double value
+   * of the literal (see operator""_val(long double)): rounding to nearest is then a double
+   * rounding, which can be one ulp off for literals very close to a halfway case. If long double
+   * has no more digits than the target type, the literal is converted unchanged.
+   *
+   * The conversion to floating-point types never throws unless the value is outside the finite
+   * range of the target type.
+   *
+   * @tparam _Style One of std::round_to_nearest (ties to even), std::round_toward_zero,
+   *                std::round_toward_infinity, or std::round_toward_neg_infinity.
+   */
+  template <std::float_round_style _Style>
+    struct round_t
+    {
+      static_assert(_Style != std::round_indeterminate);
+
+      /** @internal
+       * @copydoc exact_t::_S_select
+       */
+      template <floating_point _Up>
+        static consteval _Up
+        _S_select(const __neighbors<_Up>& __n, long double, bool __negative)
+        {
+          if constexpr (_Style == std::round_toward_zero)
+            return __n._M_down;
+          else if constexpr (_Style == std::round_toward_infinity)
+            return __negative ? __n._M_down : __n._M_up;
+          else if constexpr (_Style == std::round_toward_neg_infinity)
+            return __negative ? __n._M_up : __n._M_down;
+          else if (__n._M_half < 0 || (__n._M_half == 0 && __n._M_down_even))
+            return __n._M_down;
+          else
+            return __n._M_up;
+        }
+    };
+
+  /**
+   * @brief Conversion policy: round to nearest, but at most @p _Np ulp away from the value of the
+   * constant (the long double value for floating-point literals, see round_t).
+   *
+   * The ulp is the spacing of the target type at the value, i.e. determined from the exponent of
+   * the value and the number of significand digits of the target type, and `denorm_min` in the
+   * subnormal range. Thus, the result is never more than 0.5 ulp off and `within_ulp<0>` is
+   * equivalent to `exact`. Otherwise, bad_value_preserving_cast is thrown.
+   *
+   * @tparam _Np Tolerated error in units in the last place
+   */
+  template <unsigned _Np>
+    struct within_ulp_t
+    {
+      /** @internal
+       * @copydoc exact_t::_S_select
+       */
+      template <floating_point _Up>
+        static consteval _Up
+        _S_select(const __neighbors<_Up>& __n, long double __x, bool __negative)
+        {
+          if (__n._M_exact())
+            return __n._M_down;
+          const _Up __r = round_t<std::round_to_nearest>::_S_select(__n, __x, __negative);
+          const long double __err = __r < __x ? __x - __r : __r - __x;
+          // subnormals have the spacing of the smallest normal exponent
+          const int __e = __ilogb(__x) < numeric_limits<_Up>::min_exponent - 1
+                            ? numeric_limits<_Up>::min_exponent - 1 : __ilogb(__x);
+          if (__err > _Np * __scalbn(1.L, __e - numeric_limits<_Up>::digits + 1))
+            throw bad_value_preserving_cast();
+          return __r;
+        }
+    };
+
+  /**
+   * @brief Conversion policy: apply @p _Policy and reject subnormal results.
+   *
+   * Arithmetic with subnormal (denormal) operands is very slow on many CPUs (unless FTZ/DAZ is
+   * enabled). This policy catches constants that would end up as subnormals at compile time. A
+   * result of zero is not subnormal.
+   *
+   * @tparam _Policy Conversion policy that determines the result (exact_t by default)
+   */
+  template <typename _Policy = exact_t>
+    struct no_subnormal_t
+    {
+      /** @internal
+       * @copydoc exact_t::_S_select
+       */
+      template <floating_point _Up>
+        static consteval _Up
+        _S_select(const __neighbors<_Up>& __n, long double __x, bool __negative)
+        {
+          const _Up __r = _Policy::_S_select(__n, __x, __negative);
+          __reject_subnormal(__r);
+          return __r;
+        }
+    };
+
+  /// Value-preserving conversion (the default)
+  inline constexpr exact_t exact {};
+
+  /// Round to nearest, ties to even
+  inline constexpr round_t<std::round_to_nearest> round_to_nearest {};
+
+  /// Round toward zero (truncation)
+  inline constexpr round_t<std::round_toward_zero> round_toward_zero {};
+
+  /// Round toward positive infinity
+  inline constexpr round_t<std::round_toward_infinity> round_upward {};
+
+  /// Round toward negative infinity
+  inline constexpr round_t<std::round_toward_neg_infinity> round_downward {};
+
+  /// Round to nearest with at most @p _Np ulp error
+  template <unsigned _Np>
+    inline constexpr within_ulp_t<_Np> within_ulp {};
+
+  /// Value-preserving conversion that rejects subnormal results
+  inline constexpr no_subnormal_t<> no_subnormal {};
+
+  /** @internal
+   * @brief Concept for conversion policies.
+   */
+  template <typename _Tp>
+    concept __conversion_policy = requires(const __neighbors<float>& __n) {
+      { _Tp::template _S_select<float>(__n, 1.L, false) } -> std::same_as<float>;
+    };
+
+  /** @internal
+   * @brief Convert @p __x to the floating-point type @p _Up according to @p _Policy.
+   */
+  template <floating_point _Up, __conversion_policy _Policy>
+    consteval _Up
+    __convert(const constreal& __x, _Policy)
+    {
+      const long double __v = __x._M_value;
+      if (__v == 0)
+        return static_cast<_Up>(__v);
+      const long double __a = __v < 0 ? -__v : __v;
+      __neighbors<_Up> __n = __neighbors_of<_Up>(__a);
+      if (__x._M_residual != 0)
+        __n = __with_residual(__n, (__x._M_residual > 0) != (__v < 0) ? 1 : -1);
+      const _Up __r = _Policy::_S_select(__n, __a, __v < 0);
+#ifdef VIR_VAL_REJECT_SUBNORMALS
+      __reject_subnormal(__r);
+#endif
+      return __v < 0 ? -__r : __r;
+    }
+
+  /** @internal
+   * @copydoc __convert(const constreal&, _Policy)
+   */
+  template <floating_point _Up, __conversion_policy _Policy>
+    consteval _Up
+    __convert(const constinteger& __x, _Policy)
+    {
+      const _Up __r = _Policy::_S_select(__neighbors_of<_Up>(__x._M_value),
+                                         static_cast<long double>(__x._M_value), __x._M_negative);
+#ifdef VIR_VAL_REJECT_SUBNORMALS
+      __reject_subnormal(__r);
+#endif
+      return __x._M_negative ? -__r : __r;
+    }
+
+  /** @internal
+   * @copydoc __convert(const constreal&, _Policy)
+   */
+  template <floating_point _Up, __conversion_policy _Policy>
+    consteval _Up
+    __convert(const constrational& __x, _Policy __policy)
+    { return __convert<_Up>(__to_real(__x), __policy); }
+
+  /**
+   * @brief Untyped constant with a conversion policy.
+   *
+   * Wraps a constinteger or constreal. Conversions to floating-point types use @p _Policy instead
+   * of requiring the conversion to be value-preserving. Conversions to integral types remain
+   * value-preserving.
+   *
+   * Objects of this type are created via val(x, policy) or the literal operators in the
+   * `*_literals` namespaces.
+   *
+   * @code
+   * constexpr auto pi = vir::val(3.14159265358979323846264338327950288_val, vir::round_to_nearest);
+   *
+   * auto area(std::floating_point auto r)
+   * { return pi * r * r; } // π is rounded to the type of r at compile time
+   * @endcode
+   *
+   * @tparam _Policy One of exact_t, round_t, within_ulp_t, or no_subnormal_t
+   * @tparam _Cp One of constinteger, constreal, or constrational
+   */
+  template <typename _Policy, typename _Cp>
+    struct constrounded : _ConstBinaryOps
+    {
+      /// @internal The value the policy is applied to
+      _Cp _M_value;
+
+      /**
+       * @brief Unary negation operator
+       *
+       * @note The policy is applied to the negated value. Thus, `-val(x, round_upward)` rounds
+       * -x upward.
+       */
+      friend consteval constrounded
+      operator-(const constrounded& __v) noexcept
+      { return {{}, -__v._M_value}; }
+
+      /**
+       * @brief Unary plus operator (identity)
+       */
+      friend consteval constrounded
+      operator+(const constrounded& __v) noexcept
+      { return __v; }
+
+      /**
+       * @brief Conversion operator to arithmetic types
+       *
+       * Conversion to floating-point types applies @p _Policy to the value of the constant (see
+       * round_t). Conversion to integral types is value-preserving.
+       *
+       * @tparam _Up Target arithmetic type
+       * @return _Up Converted value
+       * @throws bad_value_preserving_cast if the policy rejects the conversion
+       */
+      template <__arithmetic _Up>
+        consteval
+        operator _Up() const
+        {
+          if constexpr (floating_point<_Up>)
+            return __convert<_Up>(_M_value, _Policy());
+          else
+            return _M_value;
+        }
+    };
+
+  /**
+   * @brief Attach a conversion policy to an untyped constant.
+   *
+   * @param __x Untyped integer constant
+   * @param __policy One of exact, round_to_nearest, round_toward_zero, round_upward,
+   *                 round_downward, within_ulp<N>, or no_subnormal
+   * @return constrounded Constant that converts according to @p __policy
+   */
+  template <__conversion_policy _Policy>
+    consteval constrounded<_Policy, constinteger>
+    val(const constinteger& __x, _Policy) noexcept
+    { return {{}, __x}; }
+
+  /**
+   * @brief Attach a conversion policy to an untyped constant.
+   *
+   * @param __x Untyped real constant
+   * @param __policy One of exact, round_to_nearest, round_toward_zero, round_upward,
+   *                 round_downward, within_ulp<N>, or no_subnormal
+   * @return constrounded Constant that converts according to @p __policy
+   */
+  template <__conversion_policy _Policy>
+    consteval constrounded<_Policy, constreal>
+    val(const constreal& __x, _Policy) noexcept
+    { return {{}, __x}; }
+
+  /**
+   * @brief Attach a conversion policy to an untyped constant.
+   *
+   * @param __x Untyped rational constant
+   * @param __policy One of exact, round_to_nearest, round_toward_zero, round_upward,
+   *                 round_downward, within_ulp<N>, or no_subnormal
+   * @return constrounded Constant that converts according to @p __policy
+   */
+  template <__conversion_policy _Policy>
+    consteval constrounded<_Policy, constrational>
+    val(const constrational& __x, _Policy) noexcept
+    { return {{}, __x}; }
+
+  /**
+   * @brief Exact division of untyped constants with the same conversion policy.
+   *
+   * Enables e.g. `1_val / 3_val` after `using vir::to_nearest_literals::operator""_val;`.
+   */
+  template <typename _Policy, __exact_constant _Tp, __exact_constant _Up>
+    consteval constrounded<_Policy, constrational>
+    operator/(const constrounded<_Policy, _Tp>& __a, const constrounded<_Policy, _Up>& __b)
+    { return {{}, __a._M_value / __b._M_value}; }
+
+  /**
+   * @brief Lower and upper bound of an untyped constant in a floating-point type.
+   *
+   * Result of enclose(). If the constant is representable in @p _Tp, both bounds are equal.
+   *
+   * @tparam _Tp Floating-point type of the bounds
+   */
+  template <floating_point _Tp>
+    struct enclosure
+    {
+      /// The largest value of type _Tp that is less than or equal to the constant
+      _Tp lower;
+
+      /// The smallest value of type _Tp that is greater than or equal to the constant
+      _Tp upper;
+
+      /**
+       * @brief Whether the constant is representable in _Tp (the conversion is value-preserving)
+       */
+      constexpr bool
+      is_exact() const noexcept
+      { return lower == upper; }
+    };
+
+  /**
+   * @brief Determine the tightest interval of type @p _Tp enclosing @p __x.
+   *
+   * Computes the round-down and round-up conversions at compile time, so that interval
+   * arithmetic does not need to switch the rounding mode (`fesetround`) to materialize constants.
+   *
+   * @code
+   * constexpr auto [lo, hi] = vir::enclose<float>(0x100'0001_val); // lo < 2^24 + 1 < hi
+   * @endcode
+   *
+   * @tparam _Tp Floating-point type of the bounds
+   * @param __x Untyped integer constant
+   * @return enclosure<_Tp> with lower == upper if the conversion is value-preserving
+   * @throws bad_value_preserving_cast if @p __x is outside the finite range of @p _Tp
+   */
+  template <floating_point _Tp>
+    consteval enclosure<_Tp>
+    enclose(const constinteger& __x)
+    { return {__convert<_Tp>(__x, round_downward), __convert<_Tp>(__x, round_upward)}; }
+
+  /**
+   * @brief Determine the tightest interval of type @p _Tp enclosing @p __x.
+   *
+   * Like enclose(const constinteger&), for real constants. A floating-point literal is rounded
+   * to long double by the compiler before operator""_val sees it. Therefore, the enclosed value
+   * is the long double value of the literal. This is a sound enclosure of the decimal literal
+   * itself only if the literal is exactly representable as long double, or if no value of type
+   * @p _Tp lies within half a long double ulp of the literal. E.g.
+   * `enclose<double>(0.99999999999999999999999_val)` is [1, 1]. Results of the functions in
+   * val_math.h carry the sign of their rounding error and are enclosed soundly.
+   *
+   * For the same reason, @p _Tp must have fewer significand digits than long double: otherwise
+   * both bounds of an inexact literal (such as `.1_val`) would be its long double value.
+   *
+   * @code
+   * constexpr auto [lo, hi] = vir::enclose<float>(.1_val); // lo < 0.1 < hi
+   * constexpr auto half = vir::enclose<float>(.5_val);     // half.is_exact()
+   * @endcode
+   *
+   * @tparam _Tp Floating-point type of the bounds, with fewer digits than long double
+   * @param __x Untyped real constant
+   * @return enclosure<_Tp> with lower == upper if the conversion is value-preserving
+   * @throws bad_value_preserving_cast if @p __x is outside the finite range of @p _Tp
+   */
+  template <floating_point _Tp>
+    requires (numeric_limits<_Tp>::digits < numeric_limits<long double>::digits)
+    consteval enclosure<_Tp>
+    enclose(const constreal& __x)
+    { return {__convert<_Tp>(__x, round_downward), __convert<_Tp>(__x, round_upward)}; }
+
+  /** @internal
+   * @brief Returns @p __a + @p __b and stores the rounding error in @p __err (TwoSum).
+   */
+  consteval long double
+  __two_sum(long double __a, long double __b, long double& __err) noexcept
+  {
+    const long double __s = __a + __b;
+    const long double __bb = __s - __a;
+    __err = (__a - (__s - __bb)) + (__b - __bb);
+    return __s;
+  }
+
+  /**
+   * @brief Split @p __x into a sum of @p _Np values of type @p _Tp (Cody–Waite splitting).
+   *
+   * All but the last term are rounded to nearest with @p __zero_bits trailing zero bits in their
+   * significand. Thus, multiplication of these terms with an integer of up to @p __zero_bits bits
+   * is exact, as required for range reduction in `sin`, `exp`, `log`, etc.:
+   *
+   * @code
+   * constexpr auto pi_4 = vir::atan(1_val); // <vir/val_math.h>
+   *
+   * template <std::floating_point T>
+   *   T reduce(T x, T k) // x - k * π/4 with k < 2^12
+   *   {
+   *     constexpr auto c = vir::split<T, 3>(pi_4, 12, vir::round_to_nearest);
+   *     return ((x - k * c[0]) - k * c[1]) - k * c[2];
+   *   }
+   * @endcode
+   *
+   * The last term is the remainder, converted according to @p __policy. With the default policy,
+   * the split is verified to be exact, i.e. the terms add up to @p __x exactly.
+   *
+   * The terms can only hold the precision that @p __x has. The results of the functions in
+   * val_math.h (such as vir::atan above) carry their rounding error as residual and thus provide
+   * about twice the precision of long double. A floating-point literal, however, is rounded to
+   * long double by the compiler (64 significant bits on x86). E.g. for `split<double, 3>` of a
+   * literal with 12 zero bits, the first two terms (41 bits each) already hold the whole value,
+   * and the last term is zero.
+   *
+   * @tparam _Tp Floating-point type of the terms
+   * @tparam _Np Number of terms (at least 2)
+   * @param __x Untyped real constant
+   * @param __zero_bits Number of trailing zero bits in all but the last term
+   * @param __policy Conversion policy for the last term
+   * @return std::array<_Tp, _Np> The terms in order of decreasing magnitude
+   * @throws bad_value_preserving_cast if the last term is rejected by @p __policy, or if
+   * @p __zero_bits is not less than the number of significand digits of @p _Tp
+   */
+  template <floating_point _Tp, size_t _Np = 2, __conversion_policy _Policy = exact_t>
+    consteval std::array<_Tp, _Np>
+    split(const constreal& __x, int __zero_bits, _Policy __policy = {})
+    {
+      static_assert(_Np >= 2);
+      const int __digits = numeric_limits<_Tp>::digits - __zero_bits;
+      if (__zero_bits < 0 || __digits < 1)
+        throw bad_value_preserving_cast();
+      std::array<_Tp, _Np> __r = {};
+      // the remaining value is __hi + __lo (exactly)
+      long double __lo = 0;
+      long double __hi = __two_sum(__x._M_value, __x._M_residual, __lo);
+      for (size_t __i = 0; __i < _Np - 1; ++__i)
+        {
+          const bool __negative = __hi < 0;
+          const long double __a = __negative ? -__hi : __hi;
+          __neighbors<_Tp> __n = __neighbors_of<_Tp>(__a, __digits);
+          if (__n._M_half == 0 && !__n._M_exact() && __lo != 0)
+            __n._M_half = (__lo > 0) != __negative ? 1 : -1; // __lo breaks the tie
+          const _Tp __t = round_to_nearest._S_select(__n, __a, __negative);
+          __r[__i] = __negative ? -__t : __t;
+          // exact: __r[__i] is __hi rounded to fewer digits
+          __hi = __two_sum(__hi - __r[__i], __lo, __lo);
+        }
+      __r[_Np - 1] = __convert<_Tp>(constreal{{}, __hi, __lo}, __policy);
+      return __r;
+    }
+
+  /** @internal
+   * @brief Classify a constant factor for folding of multiplication chains (see folded).
+   *
+   * @return 0 if |c| < 1 (or c is not finite), 1 if |c| >= 1, 2 if c is additionally integral,
+   * 3 if |c| is additionally a power of two. The kind of a product is the minimum of the kinds of
+   * its factors.
+   */
+  template <floating_point _Tp>
+    consteval int
+    __factor_kind(_Tp __c) noexcept
+    {
+      const long double __a = __c < 0 ? -__c : __c;
+      if (!(__a >= 1 && __a <= numeric_limits<_Tp>::max()))
+        return 0;
+      // values >= 2^(digits - 1) of long double are integral
+      const bool __integral
+        = __a >= __scalbn(1.L, numeric_limits<long double>::digits - 1) || __trunc(__a) == __a;
+      if (!__integral)
+        return 1;
+      return __scalbn(1.L, __ilogb(__a)) == __a ? 3 : 2;
+    }
+
+  /**
+   * @brief A floating-point value multiplied by constant factors, which are folded where possible.
+   *
+   * Result of fold() and of multiplying a folded with an untyped constant. Implicitly converts to
+   * @p _Tp, yielding `operand() * factor()`. Multiplication with a further constant folds both
+   * constants into one factor if that is bit-identical to multiplying twice under IEEE 754
+   * semantics. This is the case if one of the two multiplications is exact:
+   *
+   * - The first factor is a power of two @f$\geq 1@f$ and the second factor's magnitude is
+   *   @f$\geq 1@f$ (scaling by @f$2^k@f$ is exact; if it overflows, so does the product).
+   * - The first factor is integral and the second is a power of two @f$\geq 1@f$ (the product
+   *   of a subnormal with an integer is exact or normal; scaling after rounding in the normal
+   *   range is exact).
+   *
+   * Additionally, the product of the constants must be finite. Thus, `fold(x) * 2_val * 3_val`
+   * evaluates as `x * 6`, whereas `fold(x) * 3_val * 5_val` and `fold(x) * .5_val * 3_val`
+   * evaluate as written.
+   *
+   * @tparam _Tp Floating-point type
+   */
+  template <floating_point _Tp>
+    class folded
+    {
+      using _Cp = _ConstBinaryOps::_ConvertTo<_Tp>;
+
+      /** @internal
+       * @brief A constant factor converted to _Tp, and its kind (see __factor_kind).
+       */
+      struct _Factor
+      {
+        _Tp _M_value;
+
+        int _M_kind;
+
+        template <typename _Up>
+          requires std::derived_from<_Up, _ConstBinaryOps>
+          consteval
+          _Factor(const _Up& __c)
+          : _M_value(_Cp(__c)._M_value), _M_kind(__factor_kind(_M_value))
+          {}
+      };
+
+      _Tp _M_x;
+
+      _Tp _M_c;
+
+      /// @internal See __factor_kind
+      int _M_kind;
+
+      constexpr
+      folded(_Tp __x, _Tp __c, int __kind) noexcept
+      : _M_x(__x), _M_c(__c), _M_kind(__kind)
+      {}
+
+      /** @internal
+       * @brief Multiply with constant @p __c2 after multiplying with the constant in @p __p.
+       */
+      static constexpr folded
+      _S_fold(const folded& __p, const _Factor& __c2) noexcept
+      {
+        const int __k1 = __p._M_kind;
+        const int __k2 = __c2._M_kind;
+        if ((__k1 == 3 && __k2 >= 1) || (__k1 >= 2 && __k2 == 3))
+          {
+            // the product of the constants is exact unless it overflows; division by the power
+            // of two is exact
+            const _Tp __pow2 = __k2 == 3 ? __c2._M_value : __p._M_c;
+            const _Tp __other = __k2 == 3 ? __p._M_c : __c2._M_value;
+            if ((__other < 0 ? -__other : __other)
+                  <= numeric_limits<_Tp>::max() / (__pow2 < 0 ? -__pow2 : __pow2))
+              return {__p._M_x, __p._M_c * __c2._M_value, __k1 < __k2 ? __k1 : __k2};
+          }
+        return {_Tp(__p), __c2._M_value, __k2};
+      }
+
+      template <floating_point _Up>
+        friend constexpr folded<_Up>
+        fold(_Up __x) noexcept;
+
+    public:
+      /// The non-constant operand, possibly already multiplied by constants that did not fold
+      constexpr _Tp
+      operand() const noexcept
+      { return _M_x; }
+
+      /// The product of the constant factors that were folded into one
+      constexpr _Tp
+      factor() const noexcept
+      { return _M_c; }
+
+      constexpr
+      operator _Tp() const noexcept
+      { return _M_x * _M_c; }
+
+      friend constexpr folded
+      operator*(const folded& __a, _Factor __b) noexcept
+      { return _S_fold(__a, __b); }
+
+      friend constexpr folded
+      operator*(_Factor __a, const folded& __b) noexcept
+      { return _S_fold(__b, __a); }
+
+#define _GLIBCXX_FOLDED_OP(type, op)                                                               \
+      friend constexpr type                                                                        \
+      operator op(const folded& __a, _Cp __b) noexcept                                             \
+      { return _Tp(__a) op __b._M_value; }                                                          \
+                                                                                                   \
+      friend constexpr type                                                                        \
+      operator op(_Cp __a, const folded& __b) noexcept                                             \
+      { return __a._M_value op _Tp(__b); }
+
+      _GLIBCXX_FOLDED_OP(_Tp, +)
+      _GLIBCXX_FOLDED_OP(_Tp, -)
+      _GLIBCXX_FOLDED_OP(_Tp, /)
+      _GLIBCXX_FOLDED_OP(bool, ==)
+      _GLIBCXX_FOLDED_OP(bool, !=)
+      _GLIBCXX_FOLDED_OP(bool, <=)
+      _GLIBCXX_FOLDED_OP(bool, >=)
+      _GLIBCXX_FOLDED_OP(bool, <)
+      _GLIBCXX_FOLDED_OP(bool, >)
+
+#undef _GLIBCXX_FOLDED_OP
+    };
+
+  /**
+   * @brief Opt in to folding of constant factors in a multiplication chain.
+   *
+   * Multiplying a floating-point value with an untyped constant yields the same type and rounds
+   * after every multiplication. Starting the chain with fold() instead combines constant factors
+   * where the result is bit-identical (see folded):
+   *
+   * @code
+   * double y = vir::fold(x) * 2_val * 3_val; // a single multiplication: x * 6.
+   * @endcode
+   *
+   * The chain yields a folded<_Tp>, which converts to @p _Tp. Thus, assign it to a @p _Tp
+   * (not `auto`) or use it in an expression with other @p _Tp values.
+   *
+   * @param __x The non-constant factor
+   */
+  template <floating_point _Tp>
+    constexpr folded<_Tp>
+    fold(_Tp __x) noexcept
+    { return {__x, 1, 3}; }
+
+  /** @internal
+   * @brief Literal operators producing constrounded with the given policy.
+   */
+#define _GLIBCXX_ROUNDING_LITERALS(name, policy)                                                   \
+  namespace name                                                                                   \
+  {                                                                                                \
+    consteval constrounded<policy, constinteger>                                                   \
+      operator""_val(unsigned long long __x) noexcept                                              \
+    { return {{}, {{}, __x}}; }                                                                    \
+                                                                                                   \
+    consteval constrounded<policy, constreal>                                                      \
+      operator""_val(long double __x) noexcept                                                     \
+    { return {{}, {{}, __x}}; }                                                                    \
+  }
+
+  /**
+   * @brief Literals that round to nearest on conversion to floating-point types.
+   *
+   * Use `using vir::to_nearest_literals::operator""_val;` in a scope to make all `_val` literals
+   * in that scope use the round_to_nearest policy.
+   */
+  _GLIBCXX_ROUNDING_LITERALS(to_nearest_literals, round_t<std::round_to_nearest>)
+
+  /// Literals that round toward zero on conversion to floating-point types.
+  _GLIBCXX_ROUNDING_LITERALS(toward_zero_literals, round_t<std::round_toward_zero>)
+
+  /// Literals that round upward on conversion to floating-point types.
+  _GLIBCXX_ROUNDING_LITERALS(upward_literals, round_t<std::round_toward_infinity>)
+
+  /// Literals that round downward on conversion to floating-point types.
+  _GLIBCXX_ROUNDING_LITERALS(downward_literals, round_t<std::round_toward_neg_infinity>)
+
+#undef _GLIBCXX_ROUNDING_LITERALS
+
+  /** @internal
+   * @brief Convert one table element, reporting failure with its index.
+   *
+   * Typed values (e.g. from a generator computing in `int`) are first turned into untyped
+   * constants via val(), so that the same value-preserving check applies.
+   */
+  template <__arithmetic _Tp, typename _Cp>
+    consteval _Tp
+    __table_element(const _Cp& __x, size_t __i, source_location __where)
+    {
+      try
+        {
+          if constexpr (__arithmetic<_Cp>)
+            return val(__x);
+          else
+            return __x;
+        }
+      catch (const bad_value_preserving_cast&)
+        {
+          throw bad_table_element_cast(__i, __where);
+        }
+    }
+
+  /** @internal
+   * @brief The first element of a table() call, converted to @p _Tp, and the source location of
+   * the call.
+   *
+   * A defaulted source_location parameter cannot follow the element pack of table(). Instead,
+   * the implicit conversion of the first element to this type (which happens at the call site)
+   * records the location.
+   */
+  template <__arithmetic _Tp>
+    struct __table_head
+    {
+      _Tp _M_value;
+      source_location _M_where;
+
+      template <typename _Cp>
+        consteval
+        __table_head(const _Cp& __x, source_location __where = source_location::current())
+        : _M_value(__table_element<_Tp>(__x, 0, __where)), _M_where(__where)
+        {}
+    };
+
+  /**
+   * @brief Create an array of @p _Tp from a list of constants.
+   *
+   * Every element is converted value-preserving. On failure, the exception identifies the
+   * element and the source location of the table() call.
+   *
+   * @code
+   * static constexpr auto lut = vir::table<short>(1_val, 10_val, 100_val, 1000_val);
+   * @endcode
+   *
+   * @tparam _Tp Element type
+   * @param __x0, __xs Table elements (constinteger, constreal, or arithmetic values)
+   * @return std::array<_Tp, 1 + sizeof...(__xs)>
+   * @throws bad_table_element_cast if any element does not convert value-preserving
+   */
+  template <__arithmetic _Tp, typename... _Cs>
+    consteval std::array<_Tp, 1 + sizeof...(_Cs)>
+    table(__table_head<_Tp> __x0, const _Cs&... __xs)
+    {
+      size_t __i = 1;
+      return {__x0._M_value, __table_element<_Tp>(__xs, __i++, __x0._M_where)...};
+    }
+
+  /**
+   * @brief Create an empty array of @p _Tp.
+   */
+  template <__arithmetic _Tp>
+    consteval std::array<_Tp, 0>
+    table()
+    { return {}; }
+
+  /**
+   * @brief Create an array of @p _Tp from a generator function.
+   *
+   * Calls `__gen(i)` for every `i` in [0, _Np) and converts the result value-preserving to @p _Tp.
+   * The elements are produced in a plain loop, so that the cost of constant evaluation is linear
+   * in @p _Np and tables with 64Ki elements stay within the default limits of the compilers.
+   *
+   * @code
+   * static constexpr auto squares = vir::tabulate<unsigned short, 256>(
+   *                                   [](std::size_t i) consteval { return vir::val(i * i); });
+   * @endcode
+   *
+   * @tparam _Tp Element type
+   * @tparam _Np Number of elements
+   * @param __gen Generator invocable with `size_t`, returning constinteger, constreal, or an
+   *              arithmetic value
+   * @param __where Source location reported on failure (defaults to the caller)
+   * @return std::array<_Tp, _Np>
+   * @throws bad_table_element_cast if any element does not convert value-preserving
+   */
+  template <__arithmetic _Tp, size_t _Np, typename _Fp>
+    consteval std::array<_Tp, _Np>
+    tabulate(_Fp __gen, source_location __where = source_location::current())
+    {
+      std::array<_Tp, _Np> __r = {};
+      for (size_t __i = 0; __i < _Np; ++__i)
+        __r[__i] = __table_element<_Tp>(__gen(__i), __i, __where);
+      return __r;
+    }
+
+  /** @internal
+   * @brief Alignment of tabulated arrays: the array size rounded up to a power of two, capped at
+   * 64 Bytes (cache line / largest vector register).
+   */
+  template <typename _Tp, size_t _Np>
+    inline constexpr size_t __table_alignment = [] {
+      size_t __a = alignof(_Tp);
+      while (__a < 64 && __a < sizeof(_Tp) * _Np)
+        __a *= 2;
+      return __a;
+    }();
+
+  /**
+   * @brief Static, constant-initialized table of @p _Np elements produced by @p _Gen.
+   *
+   * Equivalent to tabulate<_Tp, _Np>(_Gen), but the array has static storage duration (no
+   * initialization at run time and thus no guard variable) and is aligned for vector loads.
+   *
+   * @code
+   * constexpr auto& lut = vir::tabulated<float, 1024, [](std::size_t i) consteval {
+   *                         return vir::val(static_cast<double>(i) / 4); }>;
+   * @endcode
+   */
+  template <__arithmetic _Tp, size_t _Np, auto _Gen>
+    alignas(__table_alignment<_Tp, _Np>) inline constexpr std::array<_Tp, _Np> tabulated
+      = tabulate<_Tp, _Np>(_Gen);
 }
 
 #endif
@@ -0,0 +1,745 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file val_integer.h
+ * @brief Integer kernels with value-preserving constants
+ *
+ * This header provides integer operations where one operand is an untyped constant (constinteger
+ * or constrounded). The constant is converted to the element type of the runtime operand at
+ * compile time, with the value-preserving checks of constinteger. Knowing the value of the
+ * constant reduces saturation and overflow checks to a single comparison (or min/max) against a
+ * precomputed bound.
+ *
+ * All functions accept integral types and data-parallel types with integral elements (e.g.
+ * std::simd::vec). For the latter, `min`, `max`, `select`, and `any_of` are found via ADL.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_VAL_INTEGER_H_
+#define INCLUDE_VAL_INTEGER_H_
+
+#include "val.h"
+
+#ifdef vir_lib_val_literal
+
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace vir
+{
+  /** @internal
+   * @brief Concept for integral types and data-parallel types with integral elements.
+   */
+  template <typename _Vp>
+    concept __integral_value = integral<__value_type_t<_Vp>>
+                                 && !std::same_as<__value_type_t<_Vp>, bool>;
+
+  /** @internal
+   * @brief The type of an untyped constant converted to the element type of @p _Vp.
+   */
+  template <typename _Vp>
+    using __constant_for = _ConstBinaryOps::_ConvertTo<__value_type_t<_Vp>>;
+
+  /** @internal
+   * @brief Element-wise minimum.
+   */
+  template <typename _Vp>
+    constexpr _Vp
+    __min(const _Vp& __a, const _Vp& __b)
+    {
+      if constexpr (__arithmetic<_Vp>)
+        return __b < __a ? __b : __a;
+      else
+        return min(__a, __b);
+    }
+
+  /** @internal
+   * @brief Element-wise maximum.
+   */
+  template <typename _Vp>
+    constexpr _Vp
+    __max(const _Vp& __a, const _Vp& __b)
+    {
+      if constexpr (__arithmetic<_Vp>)
+        return __a < __b ? __b : __a;
+      else
+        return max(__a, __b);
+    }
+
+  /** @internal
+   * @brief Element-wise @p __k ? @p __a : @p __b.
+   */
+  template <typename _Mp, typename _Vp>
+    constexpr _Vp
+    __select(const _Mp& __k, const _Vp& __a, const _Vp& __b)
+    {
+      if constexpr (__arithmetic<_Vp>)
+        return __k ? __a : __b;
+      else
+        return select(__k, __a, __b);
+    }
+
+  /** @internal
+   * @brief Whether any element of @p __k is true.
+   */
+  template <typename _Mp>
+    constexpr bool
+    __any(const _Mp& __k)
+    {
+      if constexpr (std::same_as<_Mp, bool>)
+        return __k;
+      else
+        return any_of(__k);
+    }
+
+  /** @internal
+   * @brief Broadcast @p __x to @p _Vp.
+   */
+  template <typename _Vp, typename _Tp>
+    constexpr _Vp
+    __splat(_Tp __x)
+    { return _Vp(static_cast<__value_type_t<_Vp>>(__x)); }
+
+  /**
+   * @brief Saturating addition of a constant.
+   *
+   * Evaluates as one min (or max) against the bound @f$\mathrm{max} - c@f$ (or
+   * @f$\mathrm{min} - c@f$) followed by a wrap-free addition. For vectors of 8- and 16-bit
+   * elements compilers emit e.g. `pminub` + `paddb`.
+   *
+   * @code
+   * std::uint8_t brighten(std::uint8_t px)
+   * { return vir::add_sat(px, 10_val); }
+   * @endcode
+   *
+   * @param __x Integral value or data-parallel type with integral elements
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @return _Vp @f$x + c@f$ clamped to the range of the element type
+   */
+  template <__integral_value _Vp>
+    constexpr _Vp
+    add_sat(const _Vp& __x, __constant_for<_Vp> __c) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      if (__c._M_value >= 0)
+        return static_cast<_Vp>(__min(__x, __splat<_Vp>(_Lp::max() - __c._M_value))
+                                  + __splat<_Vp>(__c._M_value));
+      else
+        return static_cast<_Vp>(__max(__x, __splat<_Vp>(_Lp::min() - __c._M_value))
+                                  + __splat<_Vp>(__c._M_value));
+    }
+
+  /**
+   * @copydoc add_sat(const _Vp&, __constant_for<_Vp>)
+   */
+  template <__integral_value _Vp>
+    constexpr _Vp
+    add_sat(__constant_for<_Vp> __c, const _Vp& __x) noexcept
+    { return add_sat(__x, __c); }
+
+  /**
+   * @brief Saturating subtraction of a constant.
+   *
+   * Evaluates as one max (or min) against a precomputed bound followed by a wrap-free
+   * subtraction.
+   *
+   * @param __x Integral value or data-parallel type with integral elements
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @return _Vp @f$x - c@f$ clamped to the range of the element type
+   */
+  template <__integral_value _Vp>
+    constexpr _Vp
+    sub_sat(const _Vp& __x, __constant_for<_Vp> __c) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      if (__c._M_value >= 0)
+        return static_cast<_Vp>(__max(__x, __splat<_Vp>(_Lp::min() + __c._M_value))
+                                  - __splat<_Vp>(__c._M_value));
+      else
+        return static_cast<_Vp>(__min(__x, __splat<_Vp>(_Lp::max() + __c._M_value))
+                                  - __splat<_Vp>(__c._M_value));
+    }
+
+  /**
+   * @brief Saturating subtraction from a constant.
+   *
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @param __x Integral value or data-parallel type with integral elements
+   * @return _Vp @f$c - x@f$ clamped to the range of the element type
+   */
+  template <__integral_value _Vp>
+    constexpr _Vp
+    sub_sat(__constant_for<_Vp> __c, const _Vp& __x) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      if constexpr (std::is_unsigned_v<_Tp>)
+        return static_cast<_Vp>(__splat<_Vp>(__c._M_value)
+                                  - __min(__x, __splat<_Vp>(__c._M_value)));
+      else if (__c._M_value >= 0)
+        return static_cast<_Vp>(__splat<_Vp>(__c._M_value)
+                                  - __max(__x, __splat<_Vp>(__c._M_value - _Lp::max())));
+      else
+        return static_cast<_Vp>(__splat<_Vp>(__c._M_value)
+                                  - __min(__x, __splat<_Vp>(__c._M_value - _Lp::min())));
+    }
+
+  /**
+   * @brief Saturating multiplication with a constant.
+   *
+   * The overflow check is a comparison against the precomputed bounds @f$\mathrm{max} / c@f$ and
+   * @f$\mathrm{min} / c@f$ (only one for unsigned types).
+   *
+   * @param __x Integral value or data-parallel type with integral elements
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @return _Vp @f$x \cdot c@f$ clamped to the range of the element type
+   */
+  template <__integral_value _Vp>
+    constexpr _Vp
+    mul_sat(const _Vp& __x, __constant_for<_Vp> __c) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      const _Tp __k = __c._M_value;
+      if (__k == 0)
+        return __splat<_Vp>(0);
+      else if (__k == 1)
+        return __x;
+      else if constexpr (std::is_signed_v<_Tp>)
+        {
+          if (__k == -1)
+            return sub_sat(0_val, __x);
+          // __x * __k overflows above max / below min if __x is outside [__lo, __hi] (for
+          // negative __k the roles are swapped); the product is computed on the clamped value to
+          // avoid undefined behavior
+          const _Tp __hi = __k > 0 ? _Lp::max() / __k : _Lp::min() / __k;
+          const _Tp __lo = __k > 0 ? _Lp::min() / __k : _Lp::max() / __k;
+          const _Vp __hi_v = __splat<_Vp>(__hi);
+          const _Vp __lo_v = __splat<_Vp>(__lo);
+          const _Vp __r = static_cast<_Vp>(__min(__max(__x, __lo_v), __hi_v) * __splat<_Vp>(__k));
+          return __select(__x > __hi_v, __splat<_Vp>(__k > 0 ? _Lp::max() : _Lp::min()),
+                          __select(__x < __lo_v, __splat<_Vp>(__k > 0 ? _Lp::min() : _Lp::max()),
+                                   __r));
+        }
+      else
+        {
+          const _Vp __hi_v = __splat<_Vp>(_Lp::max() / __k);
+          return __select(__x > __hi_v, __splat<_Vp>(_Lp::max()),
+                          static_cast<_Vp>(__min(__x, __hi_v) * __splat<_Vp>(__k)));
+        }
+    }
+
+  /**
+   * @copydoc mul_sat(const _Vp&, __constant_for<_Vp>)
+   */
+  template <__integral_value _Vp>
+    constexpr _Vp
+    mul_sat(__constant_for<_Vp> __c, const _Vp& __x) noexcept
+    { return mul_sat(__x, __c); }
+
+  /**
+   * @brief Addition of a constant with overflow check.
+   *
+   * The check is a single comparison against the precomputed bound @f$\mathrm{max} - c@f$ (or
+   * @f$\mathrm{min} - c@f$ for negative @p __c), instead of a flag-based or widening sequence.
+   *
+   * @code
+   * std::optional<int> next_index(int i)
+   * { return vir::checked_add(i, 4_val); }
+   * @endcode
+   *
+   * @param __x Integral value or data-parallel type with integral elements
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @return std::optional<_Vp> @f$x + c@f$, or nullopt if it overflows (in any element)
+   */
+  template <__integral_value _Vp>
+    constexpr std::optional<_Vp>
+    checked_add(const _Vp& __x, __constant_for<_Vp> __c) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      const _Tp __k = __c._M_value;
+      if (__k >= 0 ? __any(__x > __splat<_Vp>(_Lp::max() - __k))
+                   : __any(__x < __splat<_Vp>(_Lp::min() - __k)))
+        return std::nullopt;
+      return static_cast<_Vp>(__x + __splat<_Vp>(__k));
+    }
+
+  /**
+   * @copydoc checked_add(const _Vp&, __constant_for<_Vp>)
+   */
+  template <__integral_value _Vp>
+    constexpr std::optional<_Vp>
+    checked_add(__constant_for<_Vp> __c, const _Vp& __x) noexcept
+    { return checked_add(__x, __c); }
+
+  /**
+   * @brief Subtraction of a constant with overflow check.
+   *
+   * The check is a single comparison against a precomputed bound.
+   *
+   * @param __x Integral value or data-parallel type with integral elements
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @return std::optional<_Vp> @f$x - c@f$, or nullopt if it overflows (in any element)
+   */
+  template <__integral_value _Vp>
+    constexpr std::optional<_Vp>
+    checked_sub(const _Vp& __x, __constant_for<_Vp> __c) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      const _Tp __k = __c._M_value;
+      if (__k >= 0 ? __any(__x < __splat<_Vp>(_Lp::min() + __k))
+                   : __any(__x > __splat<_Vp>(_Lp::max() + __k)))
+        return std::nullopt;
+      return static_cast<_Vp>(__x - __splat<_Vp>(__k));
+    }
+
+  /**
+   * @brief Subtraction from a constant with overflow check.
+   *
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @param __x Integral value or data-parallel type with integral elements
+   * @return std::optional<_Vp> @f$c - x@f$, or nullopt if it overflows (in any element)
+   */
+  template <__integral_value _Vp>
+    constexpr std::optional<_Vp>
+    checked_sub(__constant_for<_Vp> __c, const _Vp& __x) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      const _Tp __k = __c._M_value;
+      bool __overflow;
+      if constexpr (std::is_unsigned_v<_Tp>)
+        __overflow = __any(__x > __splat<_Vp>(__k));
+      else if (__k >= 0)
+        __overflow = __any(__x < __splat<_Vp>(__k - _Lp::max()));
+      else
+        __overflow = __any(__x > __splat<_Vp>(__k - _Lp::min()));
+      if (__overflow)
+        return std::nullopt;
+      return static_cast<_Vp>(__splat<_Vp>(__k) - __x);
+    }
+
+  /**
+   * @brief Multiplication with a constant with overflow check.
+   *
+   * The check compares against the precomputed bounds @f$\mathrm{max} / c@f$ and
+   * @f$\mathrm{min} / c@f$ (only the former for unsigned types).
+   *
+   * @param __x Integral value or data-parallel type with integral elements
+   * @param __c Constant, converted value-preserving to the element type of @p __x
+   * @return std::optional<_Vp> @f$x \cdot c@f$, or nullopt if it overflows (in any element)
+   */
+  template <__integral_value _Vp>
+    constexpr std::optional<_Vp>
+    checked_mul(const _Vp& __x, __constant_for<_Vp> __c) noexcept
+    {
+      using _Tp = __value_type_t<_Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      const _Tp __k = __c._M_value;
+      if (__k == 0)
+        return __splat<_Vp>(0);
+      else if (__k == 1)
+        return __x;
+      else if constexpr (std::is_signed_v<_Tp>)
+        {
+          if (__k == -1)
+            return checked_sub(0_val, __x);
+          const _Tp __hi = __k > 0 ? _Lp::max() / __k : _Lp::min() / __k;
+          const _Tp __lo = __k > 0 ? _Lp::min() / __k : _Lp::max() / __k;
+          if (__any(__x > __splat<_Vp>(__hi)) || __any(__x < __splat<_Vp>(__lo)))
+            return std::nullopt;
+        }
+      else if (__any(__x > __splat<_Vp>(_Lp::max() / __k)))
+        return std::nullopt;
+      return static_cast<_Vp>(__x * __splat<_Vp>(__k));
+    }
+
+  /**
+   * @copydoc checked_mul(const _Vp&, __constant_for<_Vp>)
+   */
+  template <__integral_value _Vp>
+    constexpr std::optional<_Vp>
+    checked_mul(__constant_for<_Vp> __c, const _Vp& __x) noexcept
+    { return checked_mul(__x, __c); }
+
+  /** @internal
+   * @brief Sign-aware @p __a <= @p __b, like std::cmp_less_equal but also for bool and character
+   * types.
+   */
+  template <integral _Tp, integral _Up>
+    consteval bool
+    __cmp_less_equal(_Tp __a, _Up __b) noexcept
+    {
+      if constexpr (signed_integral<_Tp>)
+        if (__a < 0)
+          return !signed_integral<_Up> || static_cast<long long>(__a) <= static_cast<long long>(__b);
+      if constexpr (signed_integral<_Up>)
+        if (__b < 0)
+          return false;
+      return static_cast<unsigned long long>(__a) <= static_cast<unsigned long long>(__b);
+    }
+
+  /** @internal
+   * @brief Like std::in_range, but also for bool and character types.
+   */
+  template <integral _Up, integral _Tp>
+    consteval bool
+    __in_range(_Tp __x) noexcept
+    {
+      return __cmp_less_equal(numeric_limits<_Up>::lowest(), __x)
+               && __cmp_less_equal(__x, numeric_limits<_Up>::max());
+    }
+
+  /**
+   * @brief Integral value with a range known at compile time.
+   *
+   * Produced by bit_and(), mod(), and clamp() with constant operands, which propagate and narrow
+   * the range. A ranged converts implicitly to every integral type that can represent all values
+   * in [@p _Lo, @p _Hi], without a runtime check. Conversions that would need a check are
+   * ill-formed.
+   *
+   * @code
+   * std::uint8_t bucket(int x)
+   * { return vir::mod<64_val>(vir::bit_and<0xfff_val>(x)); } // ranged<int, 0, 63>
+   * @endcode
+   *
+   * The range is communicated to the optimizer via `[[assume]]` on every read of the value.
+   *
+   * @tparam _Tp Integral type of the value
+   * @tparam _Lo Smallest possible value
+   * @tparam _Hi Largest possible value
+   */
+  template <integral _Tp, _Tp _Lo = numeric_limits<_Tp>::lowest(),
+            _Tp _Hi = numeric_limits<_Tp>::max()>
+    requires (_Lo <= _Hi)
+    class ranged
+    {
+      _Tp _M_value;
+
+      constexpr
+      ranged(_Tp __x, int) noexcept
+      : _M_value(__x)
+      {}
+
+    public:
+      using value_type = _Tp;
+
+      /// The smallest possible value
+      static constexpr _Tp min = _Lo;
+
+      /// The largest possible value
+      static constexpr _Tp max = _Hi;
+
+      /**
+       * @brief Construct from a value of the full range of @p _Tp.
+       */
+      constexpr
+      ranged(_Tp __x) noexcept
+        requires (_Lo == numeric_limits<_Tp>::lowest() && _Hi == numeric_limits<_Tp>::max())
+      : _M_value(__x)
+      {}
+
+      /**
+       * @brief Construct from a ranged value with a subrange of [@p _Lo, @p _Hi].
+       */
+      template <integral _Up, _Up _Lo2, _Up _Hi2>
+        requires (__cmp_less_equal(_Lo, _Lo2) && __cmp_less_equal(_Hi2, _Hi))
+        constexpr
+        ranged(const ranged<_Up, _Lo2, _Hi2>& __x) noexcept
+        : _M_value(static_cast<_Tp>(__x.value()))
+        {}
+
+      /** @internal
+       * @brief Construct from @p __x without checking the range.
+       *
+       * @pre @p _Lo <= @p __x <= @p _Hi
+       */
+      static constexpr ranged
+      _S_unchecked(_Tp __x) noexcept
+      { return ranged(__x, 0); }
+
+      /**
+       * @brief Returns the value.
+       *
+       * @post @p _Lo <= value() <= @p _Hi
+       */
+      constexpr _Tp
+      value() const noexcept
+      {
+        [[assume(_Lo <= _M_value && _M_value <= _Hi)]];
+        return _M_value;
+      }
+
+      /**
+       * @brief Conversion to integral types that can represent all values in the range.
+       */
+      template <integral _Up>
+        requires (!std::same_as<_Up, bool> && __in_range<_Up>(_Lo) && __in_range<_Up>(_Hi))
+        constexpr
+        operator _Up() const noexcept
+        { return static_cast<_Up>(value()); }
+
+      /**
+       * @brief Whether the value is not zero.
+       *
+       * The conversion is implicit only if the range is a subset of [0, 1]. Otherwise, only
+       * contextual conversion (e.g. `if (r)`) is supported.
+       */
+      constexpr explicit(!(__in_range<bool>(_Lo) && __in_range<bool>(_Hi)))
+      operator bool() const noexcept
+      { return value() != 0; }
+    };
+
+  /** @internal
+   * @brief Integral type and range of integral types and ranged.
+   */
+  template <typename _Vp>
+    struct __range_traits
+    {};
+
+  template <integral _Tp>
+    struct __range_traits<_Tp>
+    {
+      using type = _Tp;
+      static constexpr _Tp _S_lo = numeric_limits<_Tp>::lowest();
+      static constexpr _Tp _S_hi = numeric_limits<_Tp>::max();
+
+      static constexpr _Tp
+      _S_value(_Tp __x) noexcept
+      { return __x; }
+    };
+
+  template <integral _Tp, _Tp _Lo, _Tp _Hi>
+    struct __range_traits<ranged<_Tp, _Lo, _Hi>>
+    {
+      using type = _Tp;
+      static constexpr _Tp _S_lo = _Lo;
+      static constexpr _Tp _S_hi = _Hi;
+
+      static constexpr _Tp
+      _S_value(const ranged<_Tp, _Lo, _Hi>& __x) noexcept
+      { return __x.value(); }
+    };
+
+  /** @internal
+   * @brief Concept for integral types (except bool) and ranged.
+   */
+  template <typename _Vp>
+    concept __range_operand = requires { typename __range_traits<_Vp>::type; }
+                                && !std::same_as<_Vp, bool>;
+
+  /** @internal
+   * @brief The ranged type for the range [@p __lo, @p __hi] of @p _Tp.
+   */
+  template <typename _Tp, auto __lo, auto __hi>
+    using __ranged_t = ranged<_Tp, static_cast<_Tp>(__lo), static_cast<_Tp>(__hi)>;
+
+  /** @internal
+   * @brief Range of bit_and(): [lower bound, upper bound].
+   */
+  template <typename _Tp>
+    consteval std::array<_Tp, 2>
+    __bit_and_range(_Tp __lo, _Tp __hi, _Tp __m) noexcept
+    {
+      if (__m >= 0)
+        return {0, __lo >= 0 && __hi < __m ? __hi : __m};
+      else // a & b <= min(a, b) for negative a and b
+        return {__lo >= 0 ? _Tp(0) : numeric_limits<_Tp>::lowest(),
+                __hi >= 0 ? __hi : (__hi < __m ? __hi : __m)};
+    }
+
+  /**
+   * @brief Bitwise AND with a constant mask, with the resulting range.
+   *
+   * @tparam _Mask Mask, converted value-preserving to the integral type of @p __x
+   * @param __x Integral value or ranged
+   * @return ranged @f$x \mathbin{\&} \mathrm{mask}@f$, with range @f$[0, \mathrm{mask}]@f$ for
+   * non-negative masks
+   */
+  template <constinteger _Mask, __range_operand _Vp,
+            typename _Tp = typename __range_traits<_Vp>::type,
+            std::array<_Tp, 2> __r = __bit_and_range<_Tp>(__range_traits<_Vp>::_S_lo,
+                                                          __range_traits<_Vp>::_S_hi, _Mask)>
+    constexpr __ranged_t<_Tp, __r[0], __r[1]>
+    bit_and(const _Vp& __x) noexcept
+    {
+      constexpr _Tp __m = _Mask;
+      return __ranged_t<_Tp, __r[0], __r[1]>::_S_unchecked(
+               static_cast<_Tp>(__range_traits<_Vp>::_S_value(__x) & __m));
+    }
+
+  /** @internal
+   * @brief Range of mod(): [lower bound, upper bound].
+   *
+   * @throws std::domain_error if @p __n is not positive
+   */
+  template <typename _Tp>
+    consteval std::array<_Tp, 2>
+    __mod_range(_Tp __lo, _Tp __hi, _Tp __n)
+    {
+      if (__n <= 0)
+        throw std::domain_error("vir::mod: divisor must be positive");
+      const _Tp __m = __n - 1;
+      return {__lo >= 0 ? _Tp(0) : __lo > -__m ? __lo : _Tp(-__m),
+              __hi <= 0 ? _Tp(0) : __hi < __m ? __hi : __m};
+    }
+
+  /**
+   * @brief Remainder of division by a positive constant, with the resulting range.
+   *
+   * @tparam _Np Divisor, converted value-preserving to the integral type of @p __x
+   * @param __x Integral value or ranged
+   * @return ranged @f$x \mathbin{\%} n@f$, with range @f$[0, n-1]@f$ for non-negative @p __x and
+   * @f$[1-n, n-1]@f$ otherwise
+   */
+  template <constinteger _Np, __range_operand _Vp,
+            typename _Tp = typename __range_traits<_Vp>::type,
+            std::array<_Tp, 2> __r = __mod_range<_Tp>(__range_traits<_Vp>::_S_lo,
+                                                      __range_traits<_Vp>::_S_hi, _Np)>
+    constexpr __ranged_t<_Tp, __r[0], __r[1]>
+    mod(const _Vp& __x) noexcept
+    {
+      constexpr _Tp __n = _Np;
+      return __ranged_t<_Tp, __r[0], __r[1]>::_S_unchecked(
+               static_cast<_Tp>(__range_traits<_Vp>::_S_value(__x) % __n));
+    }
+
+  /** @internal
+   * @brief Range of clamp(): [lower bound, upper bound].
+   *
+   * @throws std::domain_error if @p __lo2 > @p __hi2
+   */
+  template <typename _Tp>
+    consteval std::array<_Tp, 2>
+    __clamp_range(_Tp __lo, _Tp __hi, _Tp __lo2, _Tp __hi2)
+    {
+      if (__lo2 > __hi2)
+        throw std::domain_error("vir::clamp: lower bound is larger than upper bound");
+      return {__lo < __lo2 ? __lo2 : __lo > __hi2 ? __hi2 : __lo,
+              __hi < __lo2 ? __lo2 : __hi > __hi2 ? __hi2 : __hi};
+    }
+
+  /**
+   * @brief Clamp to constant bounds, with the resulting range.
+   *
+   * @tparam _Lo Lower bound, converted value-preserving to the integral type of @p __x
+   * @tparam _Hi Upper bound, converted value-preserving to the integral type of @p __x
+   * @param __x Integral value or ranged
+   * @return ranged @p __x clamped to [@p _Lo, @p _Hi]
+   */
+  template <constinteger _Lo, constinteger _Hi, __range_operand _Vp,
+            typename _Tp = typename __range_traits<_Vp>::type,
+            std::array<_Tp, 2> __r = __clamp_range<_Tp>(__range_traits<_Vp>::_S_lo,
+                                                        __range_traits<_Vp>::_S_hi, _Lo, _Hi)>
+    constexpr __ranged_t<_Tp, __r[0], __r[1]>
+    clamp(const _Vp& __x) noexcept
+    {
+      const _Tp __v = __range_traits<_Vp>::_S_value(__x);
+      return __ranged_t<_Tp, __r[0], __r[1]>::_S_unchecked(
+               __v < __r[0] ? __r[0] : __v > __r[1] ? __r[1] : __v);
+    }
+
+  /** @internal
+   * @brief Bounds of assume_in_range(), converted value-preserving to @p _Tp.
+   *
+   * @throws std::domain_error if @p __lo > @p __hi
+   */
+  template <typename _Tp>
+    consteval std::array<_Tp, 2>
+    __assume_range(_ConstBinaryOps::_ConvertTo<_Tp> __lo, _ConstBinaryOps::_ConvertTo<_Tp> __hi)
+    {
+      if (__lo._M_value > __hi._M_value)
+        throw std::domain_error("vir::assume_in_range: lower bound is larger than upper bound");
+      return {__lo._M_value, __hi._M_value};
+    }
+
+  /**
+   * @brief Tell the optimizer that @p __x lies in [@p _Lo, @p _Hi].
+   *
+   * The bounds are converted value-preserving to the type of @p __x at compile time, thus bounds
+   * that are not representable in that type, or a lower bound larger than the upper bound, are an
+   * error. The range is passed on via `[[assume]]`, which allows the compiler to drop bounds
+   * checks and pick narrower arithmetic.
+   *
+   * @code
+   * std::uint16_t channel = vir::assume_in_range<0_val, 4095_val>(decode_id(word));
+   * @endcode
+   *
+   * @tparam _Lo Lower bound (untyped constant)
+   * @tparam _Hi Upper bound (untyped constant)
+   * @param __x Arithmetic value
+   * @return _Tp @p __x
+   *
+   * @pre @p _Lo <= @p __x <= @p _Hi; otherwise the behavior is undefined
+   */
+  template <auto _Lo, auto _Hi, __arithmetic _Tp,
+            std::array<_Tp, 2> __r = __assume_range<_Tp>(_Lo, _Hi)>
+    requires std::derived_from<decltype(_Lo), _ConstBinaryOps>
+      && std::derived_from<decltype(_Hi), _ConstBinaryOps>
+    constexpr _Tp
+    assume_in_range(_Tp __x) noexcept
+    {
+      [[assume(__r[0] <= __x && __x <= __r[1])]];
+      return __x;
+    }
+
+  /** @internal
+   * @brief A positive constant converted value-preserving to the integral type @p _Tp.
+   */
+  template <integral _Tp>
+    struct __positive_constant
+    {
+      const _Tp _M_value;
+
+      /** @internal
+       * @throws bad_value_preserving_cast if @p __x is not representable as @p _Tp
+       * @throws std::domain_error if @p __x is not positive
+       */
+      consteval
+      __positive_constant(const constinteger& __x)
+      : _M_value(__x)
+      {
+        if (__x._M_negative || __x._M_value == 0)
+          throw std::domain_error("vir: constant must be positive");
+      }
+    };
+
+  /**
+   * @brief Tell the optimizer that @p __x is a multiple of @p __n.
+   *
+   * Allows the compiler to skip remainder handling of loops with trip count @p __x (e.g. after
+   * vectorization or unrolling by a divisor of @p __n).
+   *
+   * @code
+   * for (std::size_t i = 0; i < vir::assume_multiple_of(len, 8_val); ++i)
+   *   ...
+   * @endcode
+   *
+   * @param __x Integral value
+   * @param __n Positive constant, converted value-preserving to the type of @p __x
+   * @return _Tp @p __x
+   *
+   * @pre @p __x % @p __n == 0; otherwise the behavior is undefined
+   */
+  template <integral _Tp>
+    constexpr _Tp
+    assume_multiple_of(_Tp __x, __positive_constant<type_identity_t<_Tp>> __n) noexcept
+    {
+      [[assume(__x % __n._M_value == 0)]];
+      return __x;
+    }
+}
+
+#endif
+
+#endif  // INCLUDE_VAL_INTEGER_H_
+
+// vim: ft=cpp
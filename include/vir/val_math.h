@@ -0,0 +1,768 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file val_math.h
+ * @brief Numeric kernels with value-preserving constants
+ *
+ * This header provides consteval elementary functions on untyped constants and functions that
+ * take untyped constants (constinteger, constreal, constrounded) as coefficients and convert them
+ * at compile time to the type of the runtime argument.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_VAL_MATH_H_
+#define INCLUDE_VAL_MATH_H_
+
+#include "val.h"
+
+#ifdef vir_lib_val_literal
+
+#include <cmath>
+#include <stdexcept>
+
+namespace vir
+{
+  /** @internal
+   * @brief Concept for the untyped constant types.
+   */
+  template <typename _Tp>
+    concept __untyped_constant = std::same_as<_Tp, constinteger> || std::same_as<_Tp, constreal>
+                                   || std::same_as<_Tp, constrational>;
+
+  /** @internal
+   * @brief Returns @p __a + @p __b and stores the rounding error in @p __err.
+   *
+   * @pre |a| >= |b|
+   */
+  consteval long double
+  __quick_two_sum(long double __a, long double __b, long double& __err) noexcept
+  {
+    const long double __s = __a + __b;
+    __err = __b - (__s - __a);
+    return __s;
+  }
+
+  /** @internal
+   * @brief Returns @p __a * @p __b and stores the rounding error in @p __err (Dekker's TwoProduct).
+   */
+  consteval long double
+  __two_prod(long double __a, long double __b, long double& __err) noexcept
+  {
+    constexpr long double __splitter
+      = __scalbn(1.L, (numeric_limits<long double>::digits + 1) / 2) + 1;
+    const long double __p = __a * __b;
+    const long double __ca = __splitter * __a;
+    const long double __ah = __ca - (__ca - __a);
+    const long double __al = __a - __ah;
+    const long double __cb = __splitter * __b;
+    const long double __bh = __cb - (__cb - __b);
+    const long double __bl = __b - __bh;
+    __err = ((__ah * __bh - __p) + __ah * __bl + __al * __bh) + __al * __bl;
+    return __p;
+  }
+
+  /** @internal
+   * @brief Unevaluated sum of two long double values ("double-long-double").
+   *
+   * Provides about twice the precision of long double, which is sufficient for determining the
+   * correctly rounded long double result of the elementary functions below.
+   */
+  struct __ldd
+  {
+    long double _M_hi;
+
+    long double _M_lo = 0;
+
+    static consteval __ldd
+    _S_normalize(long double __hi, long double __lo) noexcept
+    {
+      __ldd __r = {};
+      __r._M_hi = __quick_two_sum(__hi, __lo, __r._M_lo);
+      return __r;
+    }
+
+    friend consteval __ldd
+    operator-(const __ldd& __a) noexcept
+    { return {-__a._M_hi, -__a._M_lo}; }
+
+    friend consteval __ldd
+    operator+(const __ldd& __a, const __ldd& __b) noexcept
+    {
+      long double __e1 = 0, __e2 = 0;
+      const long double __s = __two_sum(__a._M_hi, __b._M_hi, __e1);
+      const long double __t = __two_sum(__a._M_lo, __b._M_lo, __e2);
+      const __ldd __r = _S_normalize(__s, __e1 + __t);
+      return _S_normalize(__r._M_hi, __r._M_lo + __e2);
+    }
+
+    friend consteval __ldd
+    operator-(const __ldd& __a, const __ldd& __b) noexcept
+    { return __a + -__b; }
+
+    friend consteval __ldd
+    operator*(const __ldd& __a, const __ldd& __b) noexcept
+    {
+      long double __e = 0;
+      const long double __p = __two_prod(__a._M_hi, __b._M_hi, __e);
+      return _S_normalize(__p, __e + (__a._M_hi * __b._M_lo + __a._M_lo * __b._M_hi));
+    }
+
+    friend consteval __ldd
+    operator/(const __ldd& __a, long double __b) noexcept
+    {
+      const long double __q1 = __a._M_hi / __b;
+      long double __e1 = 0, __e2 = 0;
+      const long double __p = __two_prod(__q1, __b, __e1);
+      const long double __s = __two_sum(__a._M_hi, -__p, __e2);
+      const long double __q2 = (__s + (__e2 - __e1 + __a._M_lo)) / __b;
+      return _S_normalize(__q1, __q2);
+    }
+
+    friend consteval __ldd
+    operator/(const __ldd& __a, const __ldd& __b) noexcept
+    {
+      const long double __q1 = __a._M_hi / __b._M_hi;
+      const __ldd __r1 = __a - __b * __ldd{__q1};
+      const long double __q2 = __r1._M_hi / __b._M_hi;
+      const __ldd __r2 = __r1 - __b * __ldd{__q2};
+      const long double __q3 = __r2._M_hi / __b._M_hi;
+      return _S_normalize(__q1, __q2) + __ldd{__q3};
+    }
+
+    /// Multiplication with 2^n (exact)
+    consteval __ldd
+    _M_scale(int __n) const noexcept
+    { return {__scalbn(_M_hi, __n), __scalbn(_M_lo, __n)}; }
+
+    /// Whether the magnitude of this value is negligible relative to @p __x
+    consteval bool
+    _M_negligible_to(const __ldd& __x) const noexcept
+    {
+      constexpr long double __eps = __scalbn(1.L, -2 * numeric_limits<long double>::digits - 4);
+      const long double __a = _M_hi < 0 ? -_M_hi : _M_hi;
+      const long double __b = __x._M_hi < 0 ? -__x._M_hi : __x._M_hi;
+      return __a <= __b * __eps;
+    }
+  };
+
+  /** @internal
+   * @brief Returns the (exact) value of @p __x as __ldd.
+   */
+  consteval __ldd
+  __to_ldd(const constreal& __x) noexcept
+  { return {__x._M_value, __x._M_residual}; }
+
+  /** @internal
+   * @copydoc __to_ldd(const constreal&)
+   */
+  consteval __ldd
+  __to_ldd(const constinteger& __x) noexcept
+  {
+    const unsigned long long __m = __x._M_value;
+    const long double __hi = static_cast<long double>(__m);
+    long double __lo = 0;
+    if (__hi >= 0x1p64L) // rounded up to 2^64
+      __lo = -static_cast<long double>(-__m);
+    else if (const auto __h = static_cast<unsigned long long>(__hi); __h <= __m)
+      __lo = static_cast<long double>(__m - __h);
+    else
+      __lo = -static_cast<long double>(__h - __m);
+    const __ldd __r = __ldd::_S_normalize(__hi, __lo);
+    return __x._M_negative ? -__r : __r;
+  }
+
+  /** @internal
+   * @copydoc __to_ldd(const constreal&)
+   */
+  consteval __ldd
+  __to_ldd(const constrational& __x) noexcept
+  { return __to_ldd(__to_real(__x)); }
+
+  /** @internal
+   * @brief Returns the constreal for @p __x, which is the long double value nearest to @p __x with
+   * the remainder as residual.
+   */
+  consteval constreal
+  __to_constreal(const __ldd& __x)
+  {
+    const __ldd __r = __ldd::_S_normalize(__x._M_hi, __x._M_lo);
+    if (!(__r._M_hi <= numeric_limits<long double>::max()
+            && __r._M_hi >= numeric_limits<long double>::lowest()))
+      throw bad_value_preserving_cast();
+    return {{}, __r._M_hi, __r._M_lo};
+  }
+
+  /** @internal
+   * @brief @f$\sum_{k\ge0} s^k z^{2k+1}/(2k+1)@f$ with @f$s = \pm1@f$ (atan and atanh series).
+   *
+   * @pre |z| is small enough for fast convergence
+   */
+  consteval __ldd
+  __odd_power_series(const __ldd& __z, int __sign)
+  {
+    const __ldd __z2 = __z * __z;
+    __ldd __p = __z;
+    __ldd __sum = __z;
+    for (long double __k = 3; __k < 1000; __k += 2)
+      {
+        __p = __sign < 0 ? -(__p * __z2) : __p * __z2;
+        const __ldd __term = __p / __k;
+        if (__term._M_hi == 0 || __term._M_negligible_to(__sum))
+          break;
+        __sum = __sum + __term;
+      }
+    return __sum;
+  }
+
+  /** @internal
+   * @brief ln(2)
+   */
+  consteval __ldd
+  __ln2()
+  { return __odd_power_series(__ldd{1} / __ldd{3}, 1)._M_scale(1); }
+
+  /** @internal
+   * @brief π/2 (Machin's formula)
+   */
+  consteval __ldd
+  __pi_2()
+  {
+    return __odd_power_series(__ldd{1} / __ldd{5}, -1)._M_scale(3)
+             - __odd_power_series(__ldd{1} / __ldd{239}, -1)._M_scale(1);
+  }
+
+  /** @internal
+   * @brief Square root of @p __x.
+   */
+  consteval __ldd
+  __sqrt(const __ldd& __x)
+  {
+    if (__x._M_hi < 0)
+      throw std::domain_error("vir::sqrt: argument is negative");
+    if (__x._M_hi == 0)
+      return {0};
+    // Newton's method in long double, starting above the root
+    const long double __a = __x._M_hi;
+    long double __y = __scalbn(1.L, __ilogb(__a) / 2 + 1);
+    for (long double __next = (__y + __a / __y) / 2; __next < __y; __next = (__y + __a / __y) / 2)
+      __y = __next;
+    // two Newton steps in double-long-double precision
+    __ldd __r = {__y};
+    for (int __i = 0; __i < 2; ++__i)
+      __r = __r + (__x - __r * __r) / __r._M_scale(1);
+    return __r;
+  }
+
+  /** @internal
+   * @brief Exponential function of @p __x.
+   */
+  consteval __ldd
+  __exp(const __ldd& __x)
+  {
+    using L = numeric_limits<long double>;
+    const __ldd __ln2v = __ln2();
+    const long double __q = __x._M_hi / __ln2v._M_hi;
+    if (!(__q < L::max_exponent && __q > L::min_exponent - L::digits - 1))
+      throw bad_value_preserving_cast(); // result not representable as long double
+    const long double __k = (__q < 0 ? -__trunc(.5L - __q) : __trunc(__q + .5L));
+    // exp(x) = 2^k * exp(r)^(2^10), |r| <= ln(2)/2^11
+    constexpr int __squarings = 10;
+    const __ldd __r = (__x - __ldd{__k} * __ln2v)._M_scale(-__squarings);
+    // Taylor series of exp(r) - 1
+    __ldd __term = __r;
+    __ldd __em1 = __r;
+    for (long double __n = 2; __n < 100; ++__n)
+      {
+        __term = __term * __r / __n;
+        if (__term._M_negligible_to(__em1))
+          break;
+        __em1 = __em1 + __term;
+      }
+    // (1 + e)^2 - 1 = e * (e + 2)
+    for (int __i = 0; __i < __squarings; ++__i)
+      __em1 = __em1 * (__em1 + __ldd{2});
+    return (__em1 + __ldd{1})._M_scale(static_cast<int>(__k));
+  }
+
+  /** @internal
+   * @brief Natural logarithm of @p __x.
+   */
+  consteval __ldd
+  __log(const __ldd& __x)
+  {
+    if (!(__x._M_hi > 0))
+      throw std::domain_error("vir::log: argument is not positive");
+    // x = m * 2^e with sqrt(1/2) <= m < sqrt(2)
+    int __e = __ilogb(__x._M_hi);
+    __ldd __m = __x._M_scale(-__e);
+    if (__m._M_hi > 1.41421356237309504880168872420969808L)
+      {
+        __m = __m._M_scale(-1);
+        ++__e;
+      }
+    // log(m) = 2 atanh((m - 1) / (m + 1))
+    const __ldd __z = (__m - __ldd{1}) / (__m + __ldd{1});
+    return __odd_power_series(__z, 1)._M_scale(1) + __ldd{static_cast<long double>(__e)} * __ln2();
+  }
+
+  /** @internal
+   * @brief Returns @p __x rounded to the nearest integer (ties away from zero).
+   */
+  consteval long double
+  __round(long double __x) noexcept
+  { return __x < 0 ? -__trunc(.5L - __x) : __trunc(__x + .5L); }
+
+  /** @internal
+   * @brief Returns @f$\sin(r + q\pi/2)@f$.
+   *
+   * @pre |r| <= π/4, @p __q is integral
+   */
+  consteval __ldd
+  __sin_quadrant(const __ldd& __r, long double __q)
+  {
+    const long double __q4 = __q - __trunc((__q < 0 ? -__q : __q) / 4) * 4 * (__q < 0 ? -1 : 1);
+    const int __quadrant = (static_cast<int>(__q4) + 4) % 4;
+    // quadrant 0: sin(r), 1: cos(r), 2: -sin(r), 3: -cos(r)
+    const __ldd __r2 = __r * __r;
+    __ldd __term = __quadrant % 2 == 0 ? __r : __ldd{1};
+    __ldd __sum = __term;
+    for (long double __n = __quadrant % 2 == 0 ? 2 : 1; __n < 200; __n += 2)
+      {
+        __term = -(__term * __r2 / (__n * (__n + 1)));
+        if (__term._M_hi == 0 || __term._M_negligible_to(__sum))
+          break;
+        __sum = __sum + __term;
+      }
+    if (__sum._M_hi == 0)
+      return {0}; // no negative zero
+    return __quadrant >= 2 ? -__sum : __sum;
+  }
+
+  /** @internal
+   * @brief Sine (@p __cos == false) or cosine (@p __cos == true) of @p __x.
+   */
+  consteval __ldd
+  __sincos(const __ldd& __x, bool __cos)
+  {
+    const __ldd __pi_2v = __pi_2();
+    const long double __q = __x._M_hi / __pi_2v._M_hi;
+    if (!(__q < 0x1p30L && __q > -0x1p30L))
+      throw std::domain_error("vir::sin/cos: argument too large for accurate range reduction");
+    // x = k * π/2 + r, |r| <= π/4
+    const long double __k = __round(__q);
+    return __sin_quadrant(__x - __ldd{__k} * __pi_2v, __cos ? __k + 1 : __k);
+  }
+
+  /** @internal
+   * @brief Sine (@p __cos == false) or cosine (@p __cos == true) of @f$t\pi/2@f$.
+   *
+   * The argument reduction is exact, which makes this more accurate than __sincos for rational
+   * multiples of π.
+   *
+   * @param __pi_2v The value of __pi_2() (passed in to compute it only once per table)
+   */
+  consteval __ldd
+  __sincos_pi_2(const __ldd& __t, bool __cos, const __ldd& __pi_2v)
+  {
+    const long double __k = __round(__t._M_hi);
+    return __sin_quadrant((__t - __ldd{__k}) * __pi_2v, __cos ? __k + 1 : __k);
+  }
+
+  /** @internal
+   * @brief Arc tangent of @p __x.
+   */
+  consteval __ldd
+  __atan(const __ldd& __x)
+  {
+    if (__x._M_hi < 0)
+      return -__atan(-__x);
+    if (__x._M_hi > 1)
+      return __pi_2() - __atan(__ldd{1} / __x);
+    // atan(x) = 2 atan(x / (1 + sqrt(1 + x²))), applied three times for |x| <= tan(π/32)
+    __ldd __y = __x;
+    for (int __i = 0; __i < 3; ++__i)
+      __y = __y / (__ldd{1} + __sqrt(__ldd{1} + __y * __y));
+    return __odd_power_series(__y, -1)._M_scale(3);
+  }
+
+  /**
+   * @brief Square root of an untyped constant.
+   *
+   * The result is the correctly rounded long double value. If the square root is not
+   * representable as long double, the result records this, so that value-preserving conversions
+   * throw and conversion policies (such as round_to_nearest) round correctly to float, double, and
+   * long double.
+   *
+   * @code
+   * constexpr auto sqrt2 = vir::val(vir::sqrt(2_val), vir::round_to_nearest);
+   * float x = sqrt2;  // 1.41421356f
+   * float y = vir::sqrt(2.25_val); // 1.5f (exact)
+   * @endcode
+   *
+   * @param __x Non-negative constinteger, constreal, or constrational
+   * @return constreal
+   * @throws std::domain_error if @p __x is negative
+   */
+  template <__untyped_constant _Cp>
+    consteval constreal
+    sqrt(const _Cp& __x)
+    { return __to_constreal(__sqrt(__to_ldd(__x))); }
+
+  /**
+   * @brief Exponential function of an untyped constant.
+   *
+   * @copydetails sqrt()
+   *
+   * @param __x constinteger, constreal, or constrational
+   * @return constreal
+   * @throws bad_value_preserving_cast if the result is outside the range of long double
+   */
+  template <__untyped_constant _Cp>
+    consteval constreal
+    exp(const _Cp& __x)
+    { return __to_constreal(__exp(__to_ldd(__x))); }
+
+  /**
+   * @brief Natural logarithm of an untyped constant.
+   *
+   * @copydetails sqrt()
+   *
+   * @param __x Positive constinteger, constreal, or constrational
+   * @return constreal
+   * @throws std::domain_error if @p __x is not positive
+   */
+  template <__untyped_constant _Cp>
+    consteval constreal
+    log(const _Cp& __x)
+    { return __to_constreal(__log(__to_ldd(__x))); }
+
+  /**
+   * @brief Sine of an untyped constant (in radians).
+   *
+   * @copydetails sqrt()
+   *
+   * @param __x constinteger, constreal, or constrational with magnitude less than @f$2^{30}\pi/2@f$
+   * @return constreal
+   * @throws std::domain_error if @p __x is too large for accurate argument reduction
+   */
+  template <__untyped_constant _Cp>
+    consteval constreal
+    sin(const _Cp& __x)
+    { return __to_constreal(__sincos(__to_ldd(__x), false)); }
+
+  /**
+   * @brief Cosine of an untyped constant (in radians).
+   *
+   * @copydetails sin()
+   */
+  template <__untyped_constant _Cp>
+    consteval constreal
+    cos(const _Cp& __x)
+    { return __to_constreal(__sincos(__to_ldd(__x), true)); }
+
+  /**
+   * @brief Arc tangent of an untyped constant.
+   *
+   * @copydetails sqrt()
+   *
+   * @param __x constinteger, constreal, or constrational
+   * @return constreal in @f$[-\pi/2, \pi/2]@f$
+   */
+  template <__untyped_constant _Cp>
+    consteval constreal
+    atan(const _Cp& __x)
+    { return __to_constreal(__atan(__to_ldd(__x))); }
+
+  /**
+   * @brief Memory layout of arrays of complex values.
+   */
+  enum class complex_layout
+  {
+    /// real and imaginary parts alternate: re₀, im₀, re₁, im₁, …
+    interleaved,
+    /// all real parts, followed by all imaginary parts: re₀, re₁, …, im₀, im₁, …
+    split
+  };
+
+  /**
+   * @brief Table of FFT twiddle factors @f$w_k = e^{-2\pi ik/N}@f$ for @f$k \in [0, N/2)@f$.
+   *
+   * Every real and imaginary part is the correctly rounded value of type @p _Tp (rather than a
+   * double result narrowed to float). The table is computed at compile time; store it in a static
+   * constexpr variable to avoid any initialization at run time. Sizes up to 8192 stay within the
+   * default limits of GCC's constant evaluation (`-fconstexpr-ops-limit`).
+   *
+   * @code
+   * alignas(64) static constexpr auto w = vir::twiddles<float, 1024>();
+   * @endcode
+   *
+   * @tparam _Tp Floating-point type of the real and imaginary parts
+   * @tparam _Np FFT size (even)
+   * @tparam _Layout Order of real and imaginary parts in the returned array
+   * @return std::array<_Tp, _Np> @f$N/2@f$ complex values
+   */
+  template <floating_point _Tp, size_t _Np,
+            complex_layout _Layout = complex_layout::interleaved>
+    consteval std::array<_Tp, _Np>
+    twiddles()
+    {
+      static_assert(_Np >= 2 && _Np % 2 == 0);
+      const __ldd __pi_2v = __pi_2();
+      // cos(2πk/N) for k in [0, N/2)
+      std::array<_Tp, _Np / 2> __c = {};
+      for (size_t __k = 0; __k < _Np / 2; ++__k)
+        {
+          if (_Np % 4 == 0 && __k > _Np / 4)
+            __c[__k] = -__c[_Np / 2 - __k]; // cos(π - x) = -cos(x)
+          else // 2πk/N = (4k/N)·π/2
+            __c[__k] = __convert<_Tp>(
+                         __to_constreal(__sincos_pi_2(
+                           __ldd{static_cast<long double>(4 * __k)} / static_cast<long double>(_Np),
+                           true, __pi_2v)), round_to_nearest);
+        }
+      std::array<_Tp, _Np> __r = {};
+      for (size_t __k = 0; __k < _Np / 2; ++__k)
+        {
+          _Tp __im = 0;
+          if constexpr (_Np % 4 == 0) // sin(x) = cos(π/2 - x)
+            __im = __c[__k < _Np / 4 ? _Np / 4 - __k : __k - _Np / 4];
+          else
+            __im = __convert<_Tp>(
+                     __to_constreal(__sincos_pi_2(
+                       __ldd{static_cast<long double>(4 * __k)} / static_cast<long double>(_Np),
+                       false, __pi_2v)), round_to_nearest);
+          const size_t __i = _Layout == complex_layout::interleaved ? 2 * __k : __k;
+          const size_t __j = _Layout == complex_layout::interleaved ? 2 * __k + 1 : __k + _Np / 2;
+          __r[__i] = __c[__k];
+          __r[__j] = __im == 0 ? __im : -__im;
+        }
+      return __r;
+    }
+
+  /**
+   * @brief Symmetry of window functions.
+   */
+  enum class window_symmetry
+  {
+    /// DFT-even window of length N: the first N values of the symmetric window of length N + 1
+    periodic,
+    /// w[n] = w[N - 1 - n]
+    symmetric
+  };
+
+  /** @internal
+   * @brief Returns the window of size @p _Np with elements `_Fn::_S_eval(t, π/2)` for
+   * @f$t = 2n/M@f$ (i.e. @f$\pi n/M = t\pi/2@f$).
+   */
+  template <floating_point _Tp, size_t _Np, typename _Fn>
+    consteval std::array<_Tp, _Np>
+    __window(window_symmetry __sym)
+    {
+      static_assert(_Np >= 2);
+      const __ldd __pi_2v = __pi_2();
+      const size_t __m = __sym == window_symmetry::periodic ? _Np : _Np - 1;
+      std::array<_Tp, _Np> __r = {};
+      for (size_t __n = 0; __n < _Np; ++__n)
+        {
+          if (2 * __n > __m) // w[n] = w[M - n]
+            __r[__n] = __r[__m - __n];
+          else
+            __r[__n] = __convert<_Tp>(__to_constreal(_Fn::_S_eval(
+                                        __ldd{static_cast<long double>(2 * __n)}
+                                          / static_cast<long double>(__m), __pi_2v)),
+                                      round_to_nearest);
+        }
+      return __r;
+    }
+
+  /** @internal
+   * @brief Element function of hann_window()
+   */
+  struct __hann
+  {
+    static consteval __ldd
+    _S_eval(const __ldd& __t, const __ldd& __pi_2v)
+    {
+      const __ldd __s = __sincos_pi_2(__t, false, __pi_2v);
+      return __s * __s;
+    }
+  };
+
+  /** @internal
+   * @brief Element function of blackman_harris_window()
+   */
+  struct __blackman_harris
+  {
+    static consteval __ldd
+    _S_eval(const __ldd& __t, const __ldd& __pi_2v)
+    {
+      return (__ldd{35'875}
+                - __ldd{48'829} * __sincos_pi_2(__t * __ldd{2}, true, __pi_2v)
+                + __ldd{14'128} * __sincos_pi_2(__t * __ldd{4}, true, __pi_2v)
+                - __ldd{1'168} * __sincos_pi_2(__t * __ldd{6}, true, __pi_2v)) / 100'000.L;
+    }
+  };
+
+  /**
+   * @brief Hann window @f$w[n] = \sin^2(\pi n/M)@f$ with @f$M = N@f$ (periodic) or
+   * @f$M = N-1@f$ (symmetric).
+   *
+   * Every element is the correctly rounded value of type @p _Tp, computed at compile time.
+   *
+   * @tparam _Tp Floating-point element type
+   * @tparam _Np Window length (at least 2)
+   * @param __sym periodic (for spectral analysis, default) or symmetric (for filter design)
+   */
+  template <floating_point _Tp, size_t _Np>
+    consteval std::array<_Tp, _Np>
+    hann_window(window_symmetry __sym = window_symmetry::periodic)
+    { return __window<_Tp, _Np, __hann>(__sym); }
+
+  /**
+   * @brief 4-term Blackman-Harris window
+   * @f$w[n] = a_0 - a_1\cos(2\pi n/M) + a_2\cos(4\pi n/M) - a_3\cos(6\pi n/M)@f$ with
+   * @f$M = N@f$ (periodic) or @f$M = N-1@f$ (symmetric).
+   *
+   * The coefficients are @f$a_0 = 0.35875@f$, @f$a_1 = 0.48829@f$, @f$a_2 = 0.14128@f$, and
+   * @f$a_3 = 0.01168@f$ (exact decimal values). Every element is the correctly rounded value of
+   * type @p _Tp, computed at compile time.
+   *
+   * @copydetails hann_window()
+   */
+  template <floating_point _Tp, size_t _Np>
+    consteval std::array<_Tp, _Np>
+    blackman_harris_window(window_symmetry __sym = window_symmetry::periodic)
+    { return __window<_Tp, _Np, __blackman_harris>(__sym); }
+
+  /** @internal
+   * @brief Fused multiply-add for arithmetic types and (via ADL) data-parallel types.
+   */
+  template <typename _Vp>
+    constexpr _Vp
+    __fma(const _Vp& __a, const _Vp& __b, const _Vp& __c)
+    {
+      using std::fma;
+      return fma(__a, __b, __c);
+    }
+
+  /**
+   * @brief Evaluation scheme for poly(): Horner's method.
+   *
+   * One FMA per coefficient, all in one dependency chain. Minimal number of operations and the
+   * best choice for low degrees or when throughput is limited by the number of instructions.
+   */
+  struct horner_t {};
+
+  /**
+   * @brief Evaluation scheme for poly(): Estrin's scheme.
+   *
+   * Evaluates pairs of coefficients independently and combines them with powers @f$x^{2^k}@f$.
+   * The dependency chain is logarithmic instead of linear in the degree, which increases
+   * throughput on out-of-order cores for higher degrees (roughly 8 and above). Requires a few more
+   * multiplications than Horner's method and rounds differently.
+   */
+  struct estrin_t {};
+
+  /// Horner's method
+  inline constexpr horner_t horner {};
+
+  /// Estrin's scheme
+  inline constexpr estrin_t estrin {};
+
+  /**
+   * @brief Evaluate the polynomial @f$\sum_i c_i x^i@f$.
+   *
+   * The coefficients are converted to the element type of @p __x at compile time, using the
+   * value-preserving conversion of constinteger and constreal or the policy of constrounded. Thus,
+   * the same source yields verified float and double coefficients.
+   *
+   * @code
+   * template <typename T>
+   *   T exp_approx(T x)
+   *   {
+   *     using vir::to_nearest_literals::operator""_val;
+   *     return vir::poly(x, {1_val, 1_val, .5_val, .166666666666666666667_val,
+   *                          .0416666666666666666667_val}, vir::estrin);
+   *   }
+   * @endcode
+   *
+   * The polynomial is evaluated using FMA (std::fma or, for data-parallel types such as
+   * std::simd::vec, the `fma` overload found via ADL).
+   *
+   * @param __x Argument: floating-point type or data-parallel type with floating-point elements
+   * @param __c Coefficients @f$c_0, c_1, \ldots@f$ in order of increasing power
+   * @param __scheme horner (default) or estrin
+   * @return _Vp The value of the polynomial at @p __x
+   */
+  template <typename _Vp, size_t _Np, typename _Scheme = horner_t>
+    requires floating_point<__value_type_t<_Vp>>
+      && (std::same_as<_Scheme, horner_t> || std::same_as<_Scheme, estrin_t>)
+    constexpr _Vp
+    poly(const _Vp& __x, const _ConstBinaryOps::_ConvertTo<__value_type_t<_Vp>> (&__c)[_Np],
+         [[maybe_unused]] _Scheme __scheme = {})
+    {
+      if constexpr (std::same_as<_Scheme, horner_t>)
+        {
+          _Vp __r = _Vp(__c[_Np - 1]._M_value);
+          for (size_t __i = _Np - 1; __i > 0; --__i)
+            __r = __fma(__r, __x, _Vp(__c[__i - 1]._M_value));
+          return __r;
+        }
+      else
+        {
+          _Vp __p[_Np] = {};
+          for (size_t __i = 0; __i < _Np; ++__i)
+            __p[__i] = _Vp(__c[__i]._M_value);
+          _Vp __xn = __x;
+          for (size_t __n = _Np; __n > 1; __n = (__n + 1) / 2)
+            {
+              for (size_t __i = 0; __i < __n / 2; ++__i)
+                __p[__i] = __fma(__p[2 * __i + 1], __xn, __p[2 * __i]);
+              if (__n % 2 == 1)
+                __p[__n / 2] = __p[__n - 1];
+              __xn = __xn * __xn;
+            }
+          return __p[0];
+        }
+    }
+
+  /**
+   * @brief Evaluate @f$a x + b@f$ with a single rounding (fused multiply-add).
+   *
+   * The constants are converted to the element type of @p __x at compile time, as for poly().
+   * The result is the exact value of @f$a x + b@f$ rounded once in the current rounding mode, as
+   * specified for `fma` by IEEE 754. Thus, it is reproducible across compilers and independent of
+   * `-ffp-contract`, unlike `x * a + b`, which may or may not be contracted.
+   *
+   * @code
+   * template <typename T>
+   *   T fahrenheit(T celsius)
+   *   {
+   *     using vir::to_nearest_literals::operator""_val;
+   *     return vir::affine(celsius, 1.8_val, 32_val);
+   *   }
+   * @endcode
+   *
+   * @note Without hardware support for FMA, `std::fma` is a (slow) software implementation.
+   *
+   * @param __x Argument: floating-point type or data-parallel type with floating-point elements
+   * @param __a Factor
+   * @param __b Summand
+   * @return _Vp @f$a x + b@f$
+   */
+  template <typename _Vp>
+    requires floating_point<__value_type_t<_Vp>>
+    constexpr _Vp
+    affine(const _Vp& __x, _ConstBinaryOps::_ConvertTo<__value_type_t<_Vp>> __a,
+           _ConstBinaryOps::_ConvertTo<__value_type_t<_Vp>> __b)
+    { return __fma(__x, _Vp(__a._M_value), _Vp(__b._M_value)); }
+}
+
+#endif
+
+#endif  // INCLUDE_VAL_MATH_H_
+
+// vim: ft=cpp
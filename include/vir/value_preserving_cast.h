@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+/**
+ * @file value_preserving_cast.h
+ * @brief Value-preserving conversion of runtime values
+ *
+ * This header provides value_preserving_cast, which applies the rules of the (compile-time)
+ * conversions of constinteger and constreal to runtime values. It does not use exceptions and is
+ * thus usable with `-fno-exceptions`.
+ *
+ * Requires C++26.
+ */
+
+#ifndef INCLUDE_VALUE_PRESERVING_CAST_H_
+#define INCLUDE_VALUE_PRESERVING_CAST_H_
+
+#include "val.h"
+
+#ifdef vir_lib_val_literal
+
+#include <expected>
+
+namespace vir
+{
+  /**
+   * @brief Reason why a value_preserving_cast failed.
+   */
+  enum class cast_error : unsigned char
+  {
+    /// The value is outside the range of the target type (includes infinities and NaN).
+    out_of_range = 1,
+
+    /// The value is in range but not representable in the target type.
+    inexact,
+
+    /// The result would be subnormal (only with VIR_VAL_REJECT_SUBNORMALS).
+    subnormal,
+  };
+
+  /**
+   * @brief Policy for value_preserving_cast: terminate the program via a trap instruction if the
+   * conversion is not value-preserving.
+   */
+  struct trap_t {};
+
+  /// Trap on conversions that are not value-preserving
+  inline constexpr trap_t trap {};
+
+  /**
+   * @brief Policy for val_cast: assume that the conversion is value-preserving.
+   *
+   * No check is executed at runtime. A conversion that is not value-preserving has undefined
+   * behavior.
+   */
+  struct assume_t {};
+
+  /// Assume (without runtime check) that conversions are value-preserving
+  inline constexpr assume_t assume {};
+
+  /** @internal
+   * @brief Concept for the source and target types of value_preserving_cast.
+   */
+  template <typename _Tp>
+    concept __vp_castable = __arithmetic<_Tp> && !std::same_as<_Tp, bool>;
+
+  /** @internal
+   * @brief Result of __vp_convert: the converted value and the reason of failure (or 0).
+   */
+  template <typename _To>
+    struct __vp_result
+    {
+      _To _M_value;
+      unsigned char _M_error;
+    };
+
+  /** @internal
+   * @brief Returns @f$2^n@f$ in @p _Tp, where @f$n@f$ is the number of value bits of the
+   * integral type @p _Ip.
+   */
+  template <floating_point _Tp, integral _Ip>
+    constexpr _Tp __int_end = static_cast<_Tp>(numeric_limits<_Ip>::max() / 2 + 1) * 2;
+
+  /** @internal
+   * @brief Unsigned integer type with the size of the IEC 559 binary32 or binary64 type @p _Tp,
+   * or void for other floating-point types.
+   */
+  template <floating_point _Tp>
+    using __float_bits_t
+      = std::conditional_t<!numeric_limits<_Tp>::is_iec559, void,
+                           std::conditional_t<sizeof(_Tp) == 4, std::uint32_t,
+                                              std::conditional_t<sizeof(_Tp) == 8, std::uint64_t,
+                                                                 void>>>;
+
+  /** @internal
+   * @brief The sign bit of a floating-point bit pattern of type @p _Bits.
+   */
+  template <unsigned_integral _Bits>
+    constexpr _Bits __float_sign = _Bits(1) << (numeric_limits<_Bits>::digits - 1);
+
+  /** @internal
+   * @brief Convert @p __x to @p _To and determine whether the value is preserved.
+   *
+   * All checks are comparisons and selects, without branches. Checks that cannot fail for the
+   * given pair of types are omitted at compile time.
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    constexpr __vp_result<_To>
+    __vp_convert(_From __x) noexcept
+    {
+      using _Lt = numeric_limits<_To>;
+      using _Lf = numeric_limits<_From>;
+      constexpr unsigned char __range_err = static_cast<unsigned char>(cast_error::out_of_range);
+      constexpr unsigned char __inexact_err = static_cast<unsigned char>(cast_error::inexact);
+      if constexpr (integral<_From> && integral<_To>)
+        {
+          bool __ok = true;
+          if constexpr (_Lf::is_signed && !_Lt::is_signed)
+            __ok = (__x >= 0) & (static_cast<std::make_unsigned_t<_From>>(__x) <= _Lt::max());
+          else if constexpr (!_Lf::is_signed && _Lt::is_signed)
+            __ok = __x <= static_cast<std::make_unsigned_t<_To>>(_Lt::max());
+          else if constexpr (_Lf::digits > _Lt::digits)
+            __ok = (__x >= _Lt::lowest()) & (__x <= _Lt::max());
+          return {static_cast<_To>(__x), __ok ? static_cast<unsigned char>(0) : __range_err};
+        }
+      else if constexpr (integral<_From>)
+        {
+          const _To __r = static_cast<_To>(__x);
+          if constexpr (_Lf::digits <= _Lt::digits)
+            return {__r, 0};
+          else
+            {
+              // __r may have been rounded to 2^digits, which is out of range for _From
+              constexpr _To __end = __int_end<_To, _From>;
+              const _To __safe = __r < __end ? __r : _To();
+              const bool __ok = (__r < __end) & (static_cast<_From>(__safe) == __x);
+              return {__r, __ok ? static_cast<unsigned char>(0) : __inexact_err};
+            }
+        }
+      else
+        {
+          // With GCC, a conditional floating-point conversion keeps loops (narrow_exact) from
+          // vectorizing unless -fno-trapping-math. Thus, where the type has a bit pattern of
+          // matching size, the value is selected by masking its bits or converted
+          // unconditionally.
+          using _Bits = __float_bits_t<_From>;
+          bool __in_range;
+          _To __r;
+          bool __exact;
+          if constexpr (integral<_To>)
+            {
+              __in_range = (__x >= static_cast<_From>(_Lt::lowest())) & (__x < __int_end<_From, _To>);
+              if constexpr (!std::is_void_v<_Bits>)
+                __r = static_cast<_To>(std::bit_cast<_From>(std::bit_cast<_Bits>(__x)
+                                                              & -static_cast<_Bits>(__in_range)));
+              else
+                __r = static_cast<_To>(__in_range ? __x : _From());
+              __exact = static_cast<_From>(__r) == __x;
+            }
+          else
+            {
+              constexpr _From __max = _Lt::max() < _Lf::max() ? static_cast<_From>(_Lt::max())
+                                                              : _Lf::max();
+              if constexpr (!std::is_void_v<_Bits> && _Lt::is_iec559)
+                {
+                  // IEC 559 rounds values beyond the range of _To to ±inf, thus only constant
+                  // evaluation needs the select
+                  const _Bits __bits = std::bit_cast<_Bits>(__x);
+                  __in_range = (__bits & ~__float_sign<_Bits>) <= std::bit_cast<_Bits>(__max);
+                  if consteval
+                    {
+                      __r = static_cast<_To>(__in_range ? __x : _From());
+                    }
+                  else
+                    {
+                      __r = static_cast<_To>(__x);
+                    }
+                  __exact = std::bit_cast<_Bits>(static_cast<_From>(__r)) == __bits;
+                }
+              else
+                {
+                  __in_range = (__x < 0 ? -__x : __x) <= __max; // false for NaN
+                  __r = static_cast<_To>(__in_range ? __x : _From());
+                  __exact = static_cast<_From>(__r) == __x;
+                }
+            }
+          unsigned char __err = static_cast<unsigned char>(!__in_range * __range_err
+                                                             + (__in_range & !__exact) * __inexact_err);
+#ifdef VIR_VAL_REJECT_SUBNORMALS
+          if constexpr (floating_point<_To>)
+            if (__r != 0 && __r < _Lt::min() && __r > -_Lt::min() && __err == 0)
+              __err = static_cast<unsigned char>(cast_error::subnormal);
+#endif
+          return {__r, __err};
+        }
+    }
+
+  /**
+   * @brief Value-preserving conversion of a runtime value.
+   *
+   * Applies the same rules as the conversions of constinteger and constreal: the conversion
+   * succeeds if and only if @p __x is in the range of @p _To and converting back yields @p __x.
+   * Infinities and NaN are never value-preserving. With VIR_VAL_REJECT_SUBNORMALS subnormal
+   * results fail as well.
+   *
+   * The checks are branchless and specialized for the pair of types, e.g. int64_t → int32_t is
+   * two comparisons and double → float is a range comparison plus a round-trip comparison.
+   * Widening integer conversions and integer → floating-point conversions that cannot round do
+   * not check at all. Widening floating-point conversions (e.g. float → double) still compare
+   * against the finite range, since infinities and NaN are rejected.
+   *
+   * @code
+   * std::expected<float, vir::cast_error> f = vir::value_preserving_cast<float>(x);
+   * @endcode
+   *
+   * @tparam _To Target arithmetic type
+   * @param __x Value to convert
+   * @return std::expected<_To, cast_error> The converted value or the reason of failure
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    constexpr std::expected<_To, cast_error>
+    value_preserving_cast(_From __x) noexcept
+    {
+      const __vp_result<_To> __r = __vp_convert<_To>(__x);
+      if (__r._M_error != 0) [[unlikely]]
+        return std::unexpected(static_cast<cast_error>(__r._M_error));
+      return __r._M_value;
+    }
+
+  /**
+   * @brief Value-preserving conversion of a runtime value; traps on failure.
+   *
+   * Same as value_preserving_cast(_From), but executes a trap instruction (terminating the
+   * program) if the value is not preserved. During constant evaluation a failed conversion is
+   * ill-formed.
+   *
+   * @tparam _To Target arithmetic type
+   * @param __x Value to convert
+   * @return _To The converted value
+   */
+  template <__vp_castable _To, __vp_castable _From>
+    constexpr _To
+    value_preserving_cast(_From __x, trap_t) noexcept
+    {
+      const __vp_result<_To> __r = __vp_convert<_To>(__x);
+      if (__r._M_error != 0) [[unlikely]]
+        __builtin_trap();
+      return __r._M_value;
+    }
+
+  /** @internal
+   * @brief Never defined. A call that is not removed by the optimizer is a compile error.
+   */
+  [[gnu::error("val_cast: the conversion of a constant is not value-preserving")]]
+  void __val_cast_failed() noexcept;
+
+  /**
+   * @brief Value-preserving conversion that is checked at compile time whenever the value is
+   * known.
+   *
+   * This is the counterpart of val() for generic `constexpr` code, where a value may be a
+   * constant (in constant evaluation or after inlining) or a runtime value:
+   *
+   * - During constant evaluation, a conversion that is not value-preserving throws
+   *   bad_value_preserving_cast, i.e. the expression is not a constant expression.
+   * - If the optimizer can fold the check (`__builtin_constant_p`), a failing conversion is a
+   *   compile error and a succeeding conversion costs nothing.
+   * - Otherwise, the check is executed at runtime and traps on failure (trap_t), or it is
+   *   turned into `[[assume]]` (assume_t).
+   *
+   * @code
+   * template <typename T>
+   *   constexpr T
+   *   scale(T x, int k)
+   *   { return x * vir::val_cast<T>(k); }
+   * @endcode
+   *
+   * @tparam _To Target arithmetic type
+   * @param __x Value to convert
+   * @return _To The converted value
+   */
+  template <__vp_castable _To, __vp_castable _From, typename _Policy = trap_t>
+    requires std::same_as<_Policy, trap_t> || std::same_as<_Policy, assume_t>
+    constexpr _To
+    val_cast(_From __x, _Policy = {})
+    {
+      const __vp_result<_To> __r = __vp_convert<_To>(__x);
+      if consteval
+        {
+          if (__r._M_error != 0)
+            throw bad_value_preserving_cast();
+        }
+      else
+        {
+          if (__builtin_constant_p(__r._M_error) && __r._M_error != 0)
+            __val_cast_failed();
+          if constexpr (std::same_as<_Policy, assume_t>)
+            [[assume(__r._M_error == 0)]];
+          else if (__r._M_error != 0) [[unlikely]]
+            __builtin_trap();
+        }
+      return __r._M_value;
+    }
+}
+
+#endif
+
+#endif  // INCLUDE_VALUE_PRESERVING_CAST_H_
+
+// vim: ft=cpp
@@ -41,6 +41,26 @@ static_assert([] {
   return true;
 }());
 
+static_assert([] {
+  int a = 10_val;
+  a -= 4_val;
+  a *= 3_val;
+  a /= 2_val;
+  a %= 5_val;
+  a |= 8_val;
+  a &= 12_val;
+  a ^= 1_val;
+  double b = 3_val;
+  b *= 2_val;
+  b /= 4_val;
+  return a == 13 && b == 1.5;
+}());
+
+// exact arithmetic of integer constants
+static_assert(int(4_val * -2_val + 1_val) == -7);
+static_assert(int(3_val - 5_val) == -2);
+static_assert(static_cast<unsigned long long>(0xffff'ffff'ffff'fffe_val + 1_val) == ~0ull);
+
 constexpr int a = vir::val(int(-0x8000'0000));
 static_assert(a == -0x8000'0000_val);
 
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val_integer.h>
+
+#include <cstdint>
+
+using vir::operator""_val;
+
+template <auto lo, auto hi, typename T>
+  concept assumable = requires(T x) { vir::assume_in_range<lo, hi>(x); };
+
+static_assert(vir::assume_in_range<0_val, 4095_val>(5) == 5);
+static_assert(vir::assume_in_range<0_val, 4095_val>(std::uint16_t(4095)) == 4095);
+static_assert(vir::assume_in_range<-2_val, .5_val>(-1.5) == -1.5);
+static_assert(vir::assume_in_range<7_val, 7_val>(7) == 7);
+
+static_assert(assumable<0_val, 255_val, std::uint8_t>);
+static_assert(not assumable<0_val, 4095_val, std::uint8_t>); // 4095 is not a uint8_t
+static_assert(not assumable<-1_val, 10_val, unsigned>);
+static_assert(not assumable<4095_val, 0_val, int>);          // swapped bounds
+static_assert(not assumable<.5_val, -2_val, double>);
+static_assert(vir::assume_multiple_of(16u, 8_val) == 16);
+static_assert(vir::assume_multiple_of(-24, 8_val) == -24);
+
+static_assert([] {
+  try
+    {
+      vir::assume_multiple_of(8, 0_val);
+      return false;
+    }
+  catch (const std::domain_error&) {}
+  try
+    {
+      vir::assume_multiple_of(8, -8_val);
+      return false;
+    }
+  catch (const std::domain_error&) {}
+  return true;
+}());
+
+int main(int argc, char**)
+{
+  const unsigned n = vir::assume_multiple_of(static_cast<unsigned>(argc) * 8u, 8_val);
+  return vir::assume_in_range<0_val, 15_val>(n % 16u) < 16 ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/at.h>
+
+#include <vector>
+
+using vir::operator""_val;
+
+template <typename R, auto i>
+  concept valid_at = requires(R&& r) { vir::at(static_cast<R&&>(r), i); };
+
+constexpr std::array<int, 4> arr = {1, 2, 3, 4};
+constexpr std::array<int, 0> arr0 = {};
+constexpr int carr[3] = {5, 6, 7};
+
+// forces constant evaluation of the index check
+template <const auto& r, auto i>
+  concept constant_at = requires { typename std::integral_constant<int, vir::at(r, i)>; };
+
+static_assert(vir::at(arr, 0_val) == 1);
+static_assert(vir::at(arr, 3_val) == 4);
+static_assert(vir::at(carr, 2_val) == 7);
+static_assert(vir::at(std::span(arr), 1_val) == 2);
+static_assert(vir::at(std::span(carr), vir::cw<1_val>) == 6);
+
+static_assert(std::same_as<decltype(vir::at(arr, 0_val)), const int&>);
+static_assert(std::same_as<decltype(vir::at(std::declval<std::array<int, 4>&>(), 0_val)), int&>);
+static_assert(std::same_as<decltype(vir::at(std::declval<std::span<int, 4>>(), 0_val)), int&>);
+
+// out of range or not an index
+static_assert(constant_at<arr, 3_val>);
+static_assert(!constant_at<arr, 4_val>);
+static_assert(!constant_at<arr, -1_val>);
+static_assert(constant_at<arr, vir::cw<3_val>>);
+static_assert(!constant_at<arr, vir::cw<4_val>>);
+static_assert(!constant_at<arr0, 0_val>);
+static_assert(constant_at<carr, 2_val>);
+static_assert(!constant_at<carr, 3_val>);
+static_assert(!valid_at<const std::array<int, 4>&, 1.5_val>);
+static_assert(!valid_at<const std::array<int, 4>&, 1>);
+
+// only static extents
+static_assert(!valid_at<std::span<const int>, 0_val>);
+static_assert(!valid_at<const std::vector<int>&, 0_val>);
+
+// the reference would dangle
+static_assert(!valid_at<std::array<int, 4>, 0_val>);
+
+constexpr int
+modify()
+{
+  std::array<int, 2> a = {};
+  vir::at(a, 1_val) = 3;
+  int c[2] = {};
+  vir::at(std::span(c), 0_val) = 2;
+  return a[1] + c[0];
+}
+
+static_assert(modify() == 5);
+
+int main()
+{}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/cast_statistics.h>
+
+#include <cstdint>
+#include <latch>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+static_assert(vir::__arithmetic_name<std::int16_t>() == "int16");
+static_assert(vir::__arithmetic_name<std::uint64_t>() == "uint64");
+static_assert(vir::__arithmetic_name<double>() == "double");
+static_assert(std::is_trivially_destructible_v<vir::cast_site>);
+
+// constant-initialized; registered on its first count only
+constinit vir::cast_site unused;
+
+// counts per pair of types
+constinit vir::cast_site to_float_site;
+
+template <typename T>
+  std::size_t
+  to_float(const std::vector<T>& data)
+  {
+    std::size_t ok = 0;
+    for (T x : data)
+      ok += vir::value_preserving_cast<float>(x, to_float_site).has_value();
+    return ok;
+  }
+
+constinit vir::cast_site to_int_site;
+constinit vir::cast_site to_short_site;
+
+const vir::cast_site_statistics*
+find(const std::vector<vir::cast_site_statistics>& stats, const vir::cast_site& site,
+     std::string_view from, std::string_view to)
+{
+  for (const auto& s : stats)
+    if (s.where.line() == site.where().line() && s.from == from && s.to == to)
+      return &s;
+  return nullptr;
+}
+
+int
+main()
+{
+  const std::vector<double> doubles = {0.5, 0.1, 1., 0x1p128};
+  const std::vector<std::int64_t> ints = {1, (std::int64_t(1) << 24) + 1};
+
+  // counts of finished and running threads add up
+  std::vector<std::jthread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&] { to_float(doubles); });
+  threads.clear();
+  if (to_float(doubles) != 2 || to_float(ints) != 1)
+    return 1;
+
+  std::vector<vir::cast_site_statistics> stats = vir::cast_statistics();
+  const vir::cast_site_statistics* d = find(stats, to_float_site, "double", "float");
+  const vir::cast_site_statistics* i = find(stats, to_float_site, "int64", "float");
+  if (stats.size() != 2 || !d || !i)
+    return 2;
+  if (d->attempts != 20 || d->failures != 10 || i->attempts != 2 || i->failures != 1)
+    return 3;
+
+  // attempts beyond the flush interval and alternating sites, counted by this thread
+  for (int k = 0; k < 5000; ++k)
+    {
+      (void)vir::value_preserving_cast<int>(k * 0.5, to_int_site);
+      (void)vir::value_preserving_cast<short>(k * 0.5, to_short_site);
+    }
+  stats = vir::cast_statistics();
+  const vir::cast_site_statistics* n = find(stats, to_int_site, "double", "int32");
+  const vir::cast_site_statistics* s = find(stats, to_short_site, "double", "int16");
+  if (!n || n->attempts != 5000 || n->failures != 2500 || !s || s->attempts != 5000)
+    return 4;
+
+  // failures of a running thread are exact, its attempts are published in batches
+  std::latch counted(1);
+  std::latch done(1);
+  std::jthread worker([&] {
+    for (int k = 0; k < 10; ++k)
+      (void)vir::value_preserving_cast<int>(k * 0.5, to_int_site);
+    counted.count_down();
+    done.wait();
+  });
+  counted.wait();
+  stats = vir::cast_statistics();
+  n = find(stats, to_int_site, "double", "int32");
+  if (!n || n->failures != 2505 || n->attempts < 5000 || n->attempts > 5010)
+    return 5;
+  done.count_down();
+  worker.join();
+  stats = vir::cast_statistics();
+  n = find(stats, to_int_site, "double", "int32");
+  if (!n || n->attempts != 5010 || n->failures != 2505)
+    return 6;
+  vir::print_cast_statistics(stdout);
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val_integer.h>
+
+#include <cstdint>
+
+using vir::operator""_val;
+
+using u8 = std::uint8_t;
+using i16 = std::int16_t;
+
+static_assert(vir::checked_add(u8(245), 10_val) == 255);
+static_assert(!vir::checked_add(u8(246), 10_val));
+static_assert(vir::checked_add(10_val, 5) == 15);
+static_assert(vir::checked_add(i16(-32758), -10_val) == -32768);
+static_assert(!vir::checked_add(i16(-32759), -10_val));
+static_assert(!vir::checked_add(0x7fff'ffff, 1_val));
+static_assert(vir::checked_add(0x7fff'ffff, 0_val) == 0x7fff'ffff);
+
+static_assert(vir::checked_sub(u8(10), 10_val) == 0);
+static_assert(!vir::checked_sub(u8(9), 10_val));
+static_assert(vir::checked_sub(i16(32757), -10_val) == 32767);
+static_assert(!vir::checked_sub(i16(32758), -10_val));
+static_assert(!vir::checked_sub(0, -0x8000'0000_val));
+static_assert(vir::checked_sub(-1, -0x8000'0000_val) == 0x7fff'ffff);
+static_assert(vir::checked_sub(10_val, u8(10)) == 0);
+static_assert(!vir::checked_sub(10_val, u8(11)));
+static_assert(!vir::checked_sub(0_val, i16(-32768)));
+static_assert(vir::checked_sub(-1_val, i16(-32768)) == 32767);
+static_assert(!vir::checked_sub(-2_val, i16(32767)));
+
+static_assert(vir::checked_mul(u8(85), 3_val) == 255);
+static_assert(!vir::checked_mul(u8(86), 3_val));
+static_assert(vir::checked_mul(i16(-16384), 2_val) == -32768);
+static_assert(!vir::checked_mul(i16(16384), 2_val));
+static_assert(!vir::checked_mul(i16(-16385), 2_val));
+static_assert(!vir::checked_mul(i16(-16384), -2_val));
+static_assert(vir::checked_mul(i16(16384), -2_val) == -32768);
+static_assert(!vir::checked_mul(i16(-32768), -1_val));
+static_assert(vir::checked_mul(-3_val, i16(100)) == -300);
+static_assert(vir::checked_mul(0x7fff'ffff, 0_val) == 0);
+
+int main()
+{}
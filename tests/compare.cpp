@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val.h>
+
+#include <cstdint>
+
+using vir::operator""_val;
+
+// constant above the range
+static_assert([] {
+  std::int8_t x = 5;
+  return x < 1000_val && x <= 1000_val && !(x > 1000_val) && !(x >= 1000_val) && !(x == 1000_val)
+           && x != 1000_val && 1000_val > x && !(1000_val < x);
+}());
+
+// constant below the range
+static_assert([] {
+  unsigned u = 3;
+  return u >= 0_val && u > -1_val && !(u < -1_val) && u != -1_val && -1_val < u
+           && !(-1_val == u) && std::uint8_t(0) > -0x8000'0000'0000'0000_val;
+}());
+
+// in range: compared in the operand type
+static_assert([] {
+  std::uint8_t x = 255;
+  std::int16_t y = -32768;
+  return x == 255_val && x < 256_val && !(x < 255_val) && y == -32768_val && y < -32767_val
+           && y > -32769_val && 0xffff'ffff'ffff'ffff_val == ~0ull && 0x1p60_val > 1ll << 59;
+}());
+
+// generic code over integer widths
+template <typename T>
+  constexpr bool
+  fits_in_12_bits(T x)
+  { return x >= 0_val && x < 4096_val; }
+
+static_assert(fits_in_12_bits(std::uint8_t(255)));
+static_assert(fits_in_12_bits(std::int8_t(1)));
+static_assert(!fits_in_12_bits(std::int8_t(-1)));
+static_assert(fits_in_12_bits(4095u));
+static_assert(!fits_in_12_bits(4096ll));
+
+// non-integral constants are still value-preserving
+static_assert([] {
+  try
+    {
+      int x = 1;
+      return x < 0.5_val;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  return true;
+}());
+
+int main()
+{}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/constant_wrapper.h>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+using vir::operator""_val;
+using vir::cw;
+using vir::constant_wrapper;
+
+// construction
+static_assert(std::same_as<decltype(cw<8_val>), const constant_wrapper<8_val>>);
+static_assert(std::same_as<decltype(cw<8>), decltype(cw<8_val>)>);
+static_assert(std::same_as<decltype(cw<std::integral_constant<short, 8>{}>), decltype(cw<8_val>)>);
+static_assert(std::same_as<decltype(-cw<8_val>), constant_wrapper<-8_val>>);
+static_assert(std::same_as<decltype(cw<-8>), const constant_wrapper<-8_val>>);
+static_assert(std::same_as<decltype(cw<8_val>)::value_type, vir::constinteger>);
+
+// value-preserving conversions
+static_assert(int(cw<8_val>) == 8);
+static_assert(float(cw<0.5_val>) == .5f);
+static_assert(std::convertible_to<constant_wrapper<255_val>, std::uint8_t>);
+static_assert(!std::convertible_to<constant_wrapper<256_val>, std::uint8_t>);
+static_assert(!std::convertible_to<constant_wrapper<-1_val>, unsigned>);
+static_assert(!std::convertible_to<constant_wrapper<0.1_val>, float>);
+static_assert(std::array<int, cw<3_val>>().size() == 3);
+
+// interop with std::integral_constant
+constexpr std::integral_constant<short, 8> ic8 = cw<8_val>;
+static_assert(ic8() == 8);
+static_assert(!std::convertible_to<constant_wrapper<8_val>, std::integral_constant<short, 9>>);
+static_assert(!std::convertible_to<constant_wrapper<300_val>, std::integral_constant<signed char, 44>>);
+
+// arithmetic on constant_wrappers stays in the type system
+static_assert(std::same_as<decltype(cw<1_val> / cw<3_val>), constant_wrapper<1_val / 3_val>>);
+static_assert(double(cw<3_val> / cw<4_val>) == .75);
+static_assert(std::same_as<decltype(cw<4_val> * cw<2_val>), constant_wrapper<8_val>>);
+static_assert(std::same_as<decltype(cw<4_val> + cw<1_val>), constant_wrapper<5_val>>);
+static_assert(std::same_as<decltype(cw<4_val> - cw<6_val>), constant_wrapper<-2_val>>);
+static_assert(std::same_as<decltype(cw<-3_val> + cw<3_val>), constant_wrapper<0_val>>);
+static_assert(std::same_as<decltype(-cw<4_val> * cw<0_val>), constant_wrapper<0_val>>);
+static_assert(std::same_as<decltype(cw<0xffff'ffff'ffff'ffff_val> - cw<1_val>),
+                           constant_wrapper<0xffff'ffff'ffff'fffe_val>>);
+
+// the magnitude of the result must fit into unsigned long long
+template <auto a, auto b>
+  concept addable = requires { typename std::integral_constant<int, (a + b, 0)>; };
+
+template <auto a, auto b>
+  concept multipliable = requires { typename std::integral_constant<int, (a * b, 0)>; };
+
+static_assert(addable<0xffff'ffff'ffff'fffe_val, 1_val>);
+static_assert(!addable<0xffff'ffff'ffff'ffff_val, 1_val>);
+static_assert(addable<-0xffff'ffff'ffff'ffff_val, 1_val>);
+static_assert(!addable<-0xffff'ffff'ffff'ffff_val, -1_val>);
+static_assert(multipliable<0x1'0000'0000_val, 0xffff'ffff_val>);
+static_assert(!multipliable<0x1'0000'0000_val, 0x1'0000'0000_val>);
+
+// comparisons of constant_wrappers
+static_assert(cw<8_val> == cw<8_val>);
+static_assert(cw<8_val> != cw<-8_val>);
+static_assert(cw<-0_val> == cw<0_val>);
+static_assert(cw<1_val / 3_val> < cw<1_val / 2_val>);
+static_assert(cw<-1_val / 3_val> > cw<-1_val / 2_val>);
+static_assert(cw<2_val / 3_val> <= cw<4_val / 6_val>);
+static_assert(cw<0xffff'ffff'ffff'ffff_val / 0xffff'ffff'ffff'fffe_val>
+                < cw<0xffff'ffff'ffff'fffe_val / 0xffff'ffff'ffff'fffd_val>);
+static_assert(cw<7_val / 2_val> >= cw<3_val>);
+static_assert(cw<3_val> < cw<7_val / 2_val>);
+static_assert(!(cw<3_val> > cw<3_val>));
+
+// arithmetic with typed values behaves like with the untyped constant
+static_assert(std::same_as<decltype(3 * cw<8_val>), int>);
+static_assert(3 * cw<8_val> == 24);
+static_assert(std::same_as<decltype(std::uint8_t(3) + cw<8_val>), std::uint8_t>);
+static_assert(cw<8_val> / 2.f == 4.f);
+static_assert(std::int8_t(-1) < cw<1000_val>);
+static_assert(cw<8_val> == 8u);
+static_assert([] { int x = 3; x *= cw<8_val>; return x; }() == 24);
+
+// a kernel specialized on its stride
+template <typename Stride>
+  constexpr float
+  sum4(const float* x, Stride stride)
+  {
+    float s = 0;
+    for (int i = 0; i < 4; ++i)
+      s += x[i * stride];
+    return s;
+  }
+
+constexpr std::array<float, 32> data = [] {
+  std::array<float, 32> r = {};
+  for (int i = 0; i < 32; ++i)
+    r[std::size_t(i)] = float(i);
+  return r;
+}();
+
+static_assert(sum4(data.data(), cw<8_val>) == 0 + 8 + 16 + 24);
+static_assert(sum4(data.data(), 8) == sum4(data.data(), cw<8_val>));
+
+// power-of-two fast path selected at compile time
+template <typename N>
+  constexpr unsigned
+  mod_n(unsigned x, N n)
+  {
+    if constexpr (requires { N::value; })
+      {
+        if constexpr ((unsigned(N::value) & (unsigned(N::value) - 1)) == 0)
+          return x & (n - 1u);
+      }
+    return x % n;
+  }
+
+static_assert(mod_n(37, cw<16_val>) == 5);
+static_assert(mod_n(37, cw<10_val>) == 7);
+static_assert(mod_n(37, 16u) == 5);
+
+int main()
+{}
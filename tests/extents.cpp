@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/extents.h>
+
+#include <cstdint>
+#include <type_traits>
+
+using vir::operator""_val;
+
+// static extents from untyped constants
+static_assert(std::same_as<vir::extents<3_val, 3_val>, std::extents<std::size_t, 3, 3>>);
+static_assert(std::same_as<vir::basic_extents<int, 5_val, 5_val>, std::extents<int, 5, 5>>);
+static_assert(std::same_as<vir::basic_extents<std::uint8_t, 255_val>, std::extents<std::uint8_t, 255>>);
+static_assert(std::same_as<vir::basic_extents<int, 4_val, std::dynamic_extent>,
+                           std::extents<int, 4, std::dynamic_extent>>);
+
+// other constants convert value-preserving as well
+static_assert(std::same_as<vir::basic_extents<short, vir::cw<4_val>, 4u, std::integral_constant<long, 2>{}>,
+                           std::extents<short, 4, 4, 2>>);
+
+template <typename I, auto x>
+  concept valid_extent = requires { typename vir::basic_extents<I, x>; };
+
+static_assert(valid_extent<std::uint8_t, 255_val>);
+static_assert(!valid_extent<std::uint8_t, 256_val>);
+static_assert(!valid_extent<int, -1_val>);
+static_assert(!valid_extent<int, 0.5_val>);
+static_assert(!valid_extent<int, std::size_t(1) << 40>);
+
+// layout with static strides
+using every_other_column = vir::layout_static_stride<6_val, 2_val>;
+using mapping = every_other_column::mapping<vir::basic_extents<int, 3_val, 3_val>>;
+static_assert(mapping::stride(0) == 6 && mapping::stride(1) == 2);
+static_assert(mapping()(2, 1) == 14);
+static_assert(mapping().required_span_size() == 17);
+static_assert(mapping::is_always_strided());
+static_assert(std::same_as<decltype(mapping()(std::size_t(1), 1)), int>);
+
+using short_mapping = vir::layout_static_stride<3_val>::mapping<vir::basic_extents<short, 4_val>>;
+static_assert(short_mapping()(3) == 9);
+static_assert(short_mapping().required_span_size() == 10);
+
+constexpr float
+trace3(const float* data)
+{
+  std::mdspan<const float, vir::extents<3_val, 3_val>, every_other_column> m(data);
+  return m[0, 0] + m[1, 1] + m[2, 2];
+}
+
+constexpr float data[18] = {0, 1, 2,  3,  4,  5,  6,  7,  8,
+                            9, 10, 11, 12, 13, 14, 15, 16, 17};
+
+static_assert(trace3(data) == 0 + 8 + 16);
+
+int main()
+{}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val.h>
+
+#include <concepts>
+
+using vir::operator""_val;
+
+// folding is opt-in: without fold() the product has the type of the operand
+static_assert(std::same_as<decltype(1.f * 2_val * 3_val), float>);
+static_assert(std::same_as<decltype(2_val * 1.), double>);
+static_assert(std::same_as<decltype(vir::fold(1.f) * 2_val * 3_val), vir::folded<float>>);
+
+// folded
+static_assert((vir::fold(1.f) * 2_val * 3_val).factor() == 6);
+static_assert((vir::fold(1.) * 3_val * 2_val).factor() == 6);
+static_assert((vir::fold(1.) * 2_val * 1.5_val).factor() == 3);
+static_assert((vir::fold(1.) * -2_val * 4_val * 3_val).factor() == -24);
+static_assert((2_val * (vir::fold(1.) * 3_val)).factor() == 6);
+
+// not folded
+static_assert((vir::fold(1.f) * 3_val * 5_val).factor() == 5);
+static_assert((vir::fold(1.f) * 3_val * 5_val).operand() == 3);
+static_assert((vir::fold(1.) * .5_val * 2_val).factor() == 2);
+static_assert((vir::fold(1.) * 1.5_val * 2_val).factor() == 2);
+static_assert((vir::fold(1.f) * 0x1p100_val * 0x1p100_val).factor() == 0x1p100f);
+static_assert((vir::fold(1.L) * 0x1p100_val * 0x1p-99_val).factor() == 0x1p-99L);
+
+// long double factors with a fractional part are not integral, also beyond 2^63
+#if __LDBL_MANT_DIG__ >= 64
+static_assert((vir::fold(1.L) * 0x1.0000000000000002p62_val * 2_val).factor() == 2);
+#endif
+#if __LDBL_MANT_DIG__ > 66
+static_assert((vir::fold(1.L) * 0x1.00000000000000008p64_val * 2_val).factor() == 2);
+#endif
+
+// same result as unfolded multiplication
+static_assert([] {
+  constexpr float dmin = std::numeric_limits<float>::denorm_min();
+  float a = vir::fold(dmin) * 1.5_val * 2_val;
+  float b = vir::fold(0x1p-100f) * 0x1p100_val * 0x1p100_val;
+  double c = vir::fold(0.1) * 2_val * 3_val;
+  return a == (dmin * 1.5f) * 2 && b == 0x1p100f && c == 0.1 * 6;
+}());
+
+// interaction with other operators
+static_assert([] {
+  double x = 1.5;
+  const auto x2 = vir::fold(x) * 2_val;
+  double a = x2 + 1_val;
+  double b = 1_val - x2;
+  double c = x2 / 3_val;
+  bool d = x2 == 3_val && x2 < 4_val && 2_val <= x2;
+  double e = x2 * x;
+  return a == 4 && b == -2 && c == 1 && d && e == 4.5;
+}());
+
+int main(int argc, char**)
+{
+  // overflow of the first multiplication is not a constant expression
+  const float max = std::numeric_limits<float>::max() * static_cast<float>(argc);
+  const float a = vir::fold(max) * 2_val * 3_val;
+  const float b = vir::fold(max) * 0x1p100_val * 0x1p100_val;
+  const float c = vir::fold(-max) * 3_val * .5_val;
+  return a == (max * 2) * 3 && b == (max * 0x1p100f) * 0x1p100f && c == (-max * 3) * .5f ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val_math.h>
+
+using vir::operator""_val;
+
+// exact in float and double: results must match for both schemes
+static_assert(vir::poly(2.f, {1_val, -3_val, .5_val}) == 1 - 6 + 2);
+static_assert(vir::poly(2., {1_val, -3_val, .5_val}, vir::estrin) == 1 - 6 + 2);
+static_assert(vir::poly(-1.f, {7_val}) == 7);
+static_assert(vir::poly(3., {1_val, 2_val, 3_val, 4_val, 5_val, 6_val, 7_val, 8_val, 9_val},
+                        vir::estrin)
+                == vir::poly(3., {1_val, 2_val, 3_val, 4_val, 5_val, 6_val, 7_val, 8_val, 9_val}));
+
+template <typename T>
+  constexpr T
+  exp_approx(T x)
+  {
+    using vir::to_nearest_literals::operator""_val;
+    return vir::poly(x, {1_val, 1_val, .5_val, .166666666666666666667_val,
+                         .0416666666666666666667_val}, vir::estrin);
+  }
+
+static_assert(exp_approx(0.f) == 1 && exp_approx(0.) == 1);
+static_assert(exp_approx(.001f) > 1.001f && exp_approx(.001f) < 1.0011f);
+
+template <typename T>
+  consteval T
+  nearest(vir::constreal x)
+  { return vir::val(x, vir::round_to_nearest); }
+
+static_assert(nearest<float>(vir::sqrt(2_val)) == 1.41421356237309504880168872420969808f);
+static_assert(nearest<double>(vir::sqrt(2_val)) == 1.41421356237309504880168872420969808);
+static_assert(nearest<long double>(vir::sqrt(2_val)) == 1.41421356237309504880168872420969808L);
+static_assert(nearest<double>(vir::exp(1_val)) == 2.71828182845904523536028747135266250);
+static_assert(nearest<long double>(vir::exp(-1_val)) == .367879441171442321595523770161460867L);
+static_assert(nearest<double>(vir::log(10_val)) == 2.30258509299404568401799145468436421);
+static_assert(nearest<long double>(vir::log(2_val)) == .693147180559945309417232121458176568L);
+static_assert(nearest<long double>(vir::cos(.392699081698724154807830422909937861_val))
+                == .923879532511286756128183189396788934L); // cos(π/8)
+static_assert(nearest<double>(vir::sin(10_val)) == -.544021110889369813404747661851377281);
+static_assert(nearest<long double>(vir::cos(-10_val)) == -.839071529076452452258863947824064835L);
+static_assert(nearest<float>(vir::atan(1_val)) == .785398163397448309615660845819875721f);
+static_assert(nearest<long double>(vir::atan(-3_val)) == -1.24904577239825442582991707728109012L);
+static_assert(nearest<double>(vir::log(vir::exp(5_val))) == 5);
+
+// exact results convert value-preserving
+static_assert([] {
+  float a = vir::sqrt(2.25_val);
+  int b = vir::sqrt(49_val);
+  float c = vir::exp(0_val);
+  float d = vir::log(1_val);
+  float e = vir::cos(0_val);
+  float f = vir::atan(0_val);
+  return a == 1.5f && b == 7 && c == 1 && d == 0 && e == 1 && f == 0;
+}());
+
+static_assert([] {
+  float a = vir::sqrt(1_val / 4_val);
+  double b = vir::val(vir::log(1_val / 2_val), vir::round_to_nearest);
+  return a == .5f && b == -0.693147180559945309417232121458176568;
+}());
+
+static_assert([] {
+  constexpr long double lower = vir::val(vir::sqrt(2_val), vir::round_downward);
+  constexpr long double upper = vir::val(vir::sqrt(2_val), vir::round_upward);
+  constexpr auto sqrt2 = vir::enclose<float>(vir::sqrt(2_val));
+  return lower < upper && lower * lower < 2 && upper * upper > 2
+           && sqrt2.lower < sqrt2.upper && sqrt2.lower * sqrt2.lower < 2
+           && sqrt2.upper * sqrt2.upper > 2;
+}());
+
+static_assert([] {
+  try
+    {
+      [[maybe_unused]] long double x = vir::sqrt(2_val); // irrational
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      vir::sqrt(-1_val);
+      return false;
+    }
+  catch (const std::domain_error&) {}
+  try
+    {
+      vir::log(0_val);
+      return false;
+    }
+  catch (const std::domain_error&) {}
+  return true;
+}());
+
+// affine
+static_assert(vir::affine(0x1.000002p0f, 0x1.fffffcp-1_val, -1_val) == -0x1p-46f); // single rounding
+static_assert(vir::affine(2., 1.5_val, -1_val) == 2);
+static_assert([] {
+  using vir::to_nearest_literals::operator""_val;
+  return vir::affine(3.f, 1_val / 3_val, 1_val) == 2 && vir::affine(10., .1_val, 0_val) == 1;
+}());
+
+static_assert([] {
+  try
+    {
+      vir::affine(1.f, .1_val, 0_val);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  return true;
+}());
+
+// twiddle factors and windows
+static_assert([] {
+  constexpr double h = 0.70710678118654752440;
+  constexpr auto w = vir::twiddles<double, 8>();
+  return w == std::array{1., 0., h, -h, 0., -1., -h, -h};
+}());
+
+static_assert([] {
+  constexpr auto w = vir::twiddles<float, 8, vir::complex_layout::split>();
+  constexpr float h = 0.70710678118654752440f;
+  return w == std::array{1.f, h, 0.f, -h, 0.f, -h, -1.f, -h};
+}());
+
+static_assert(vir::hann_window<float, 4>() == std::array{0.f, .5f, 1.f, .5f});
+static_assert(vir::hann_window<float, 5>(vir::window_symmetry::symmetric)
+                == std::array{0.f, .5f, 1.f, .5f, 0.f});
+static_assert(vir::blackman_harris_window<double, 16>()[0] == 0x1.f75104d551d69p-15); // 6e-5
+static_assert(vir::blackman_harris_window<double, 16>()[8] == 1);
+
+int main(int argc, char**)
+{
+  const float x = static_cast<float>(argc); // not a constant expression
+  return vir::poly(x, {-1_val, 1_val}) == 0 ? 0 : 1;
+}
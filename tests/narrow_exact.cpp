@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/narrow_exact.h>
+
+#include <cstdint>
+#include <vector>
+
+template <typename _To, typename _From>
+  bool
+  check(const std::vector<_From>& in, const std::vector<std::size_t>& lossy)
+  {
+    const std::span<const _From> src(in);
+    std::vector<_To> out(in.size());
+    const std::size_t first = lossy.empty() ? in.size() : lossy.front();
+    if (vir::narrow_exact(src, std::span(out)) != first)
+      return false;
+    for (std::size_t i = 0; i < first; ++i)
+      if (out[i] != in[i])
+        return false;
+    if (vir::narrow_exact(vir::parallel{4}, src, std::span(out)) != first)
+      return false;
+
+    for (vir::parallel policy : {vir::parallel{1}, vir::parallel{3}, vir::parallel{}})
+      {
+        std::vector<std::uint64_t> bitmap((in.size() + 63) / 64, ~std::uint64_t());
+        if (vir::narrow_exact(policy, src, std::span(out), std::span(bitmap)) != lossy.size())
+          return false;
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < in.size(); ++i)
+          {
+            const bool is_lossy = (bitmap[i / 64] >> (i % 64)) & 1;
+            if (is_lossy != (k < lossy.size() && lossy[k] == i))
+              return false;
+            if (is_lossy)
+              ++k;
+            else if (out[i] != in[i])
+              return false;
+          }
+      }
+    return true;
+  }
+
+int main()
+{
+  constexpr std::size_t n = 1'000'003;
+
+  std::vector<double> d(n);
+  for (std::size_t i = 0; i < n; ++i)
+    d[i] = double(i % 1000) * 0.25 - 100.;
+  if (!check<float>(d, {}))
+    return 1;
+  d[700'001] = 0.1;
+  d[900'000] = 1e300;
+  d[5] = 1. + 0x1p-30;
+  if (!check<float>(d, {5, 700'001, 900'000}))
+    return 2;
+
+  std::vector<std::int64_t> i64(n);
+  for (std::size_t i = 0; i < n; ++i)
+    i64[i] = std::int64_t(i % 65536) - 32768;
+  if (!check<std::int16_t>(i64, {}))
+    return 3;
+  i64[n - 1] = 32768;
+  i64[64] = -32769;
+  if (!check<std::int16_t>(i64, {64, n - 1}))
+    return 4;
+
+  if (!check<float>(std::vector<double>(), {}))
+    return 5;
+}
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/parse_exact.h>
+
+#include <cstdint>
+
+using vir::parse_exact;
+using vir::parse_error;
+
+template <typename _Tp>
+  constexpr bool
+  fails_with(std::string_view str, parse_error e)
+  { return parse_exact<_Tp>(str).error() == e; }
+
+// integer literals
+static_assert(parse_exact<int>("42") == 42);
+static_assert(parse_exact<int>("-2'147'483'648") == -2147483647 - 1);
+static_assert(parse_exact<std::int8_t>("+0x7f") == 127);
+static_assert(parse_exact<unsigned>("0b1010'1010") == 0xaau);
+static_assert(parse_exact<short>("0777") == 0777);
+static_assert(parse_exact<std::uint64_t>("18446744073709551615") == ~0ull);
+static_assert(parse_exact<std::int64_t>("-9223372036854775808")
+                == std::numeric_limits<std::int64_t>::min());
+static_assert(parse_exact<unsigned>("-0") == 0u);
+static_assert(fails_with<std::int16_t>("32768", parse_error::out_of_range));
+static_assert(fails_with<unsigned>("-1", parse_error::out_of_range));
+static_assert(fails_with<std::uint64_t>("18446744073709551616", parse_error::out_of_range));
+
+// floating-point literals
+static_assert(parse_exact<float>("0.125") == 0.125f);
+static_assert(parse_exact<float>("-1.5e3") == -1500.f);
+static_assert(parse_exact<double>("1e22") == 1e22);
+static_assert(parse_exact<double>(".5") == .5);
+static_assert(parse_exact<double>("5.") == 5.);
+static_assert(parse_exact<double>("0x1.8p1") == 3.);
+static_assert(parse_exact<double>("0x.8p0") == .5);
+static_assert(parse_exact<float>("0x1.fffffep127") == 0x1.fffffep127f);
+#ifndef VIR_VAL_REJECT_SUBNORMALS
+static_assert(parse_exact<float>("0x1p-149") == 0x1p-149f);
+#else
+static_assert(fails_with<float>("0x1p-149", parse_error::subnormal));
+#endif
+static_assert(parse_exact<double>("1'000.125e0'1") == 10001.25);
+static_assert(fails_with<double>("1'000.000'5e0'1", parse_error::inexact));
+static_assert(parse_exact<double>("0.0000000000000000000000000000000000000000000000000000000000000000"
+                                  "000000000000000000000000000000000001e100") == 1.0);
+static_assert(parse_exact<float>("-0.0").value() == 0.f);
+static_assert(fails_with<float>("0.1", parse_error::inexact));
+static_assert(fails_with<double>("1e23", parse_error::inexact));
+static_assert(fails_with<float>("16777217", parse_error::inexact));
+static_assert(fails_with<float>("1e39", parse_error::out_of_range));
+static_assert(fails_with<float>("0x1p128", parse_error::out_of_range));
+static_assert(fails_with<float>("0x1p-150", parse_error::inexact));
+static_assert(fails_with<double>("1e-400", parse_error::inexact));
+
+// long digit sequences (exact expansion of 2^-60 and 2^70)
+static_assert(parse_exact<double>("8.67361737988403547205962240695953369140625e-19") == 0x1p-60);
+static_assert(parse_exact<float>("1180591620717411303424.0") == 0x1p70f);
+static_assert(fails_with<float>("1180591620717411303424", parse_error::out_of_range));
+static_assert(parse_exact<double>("1180591620717411303424.000000000000000000000001").error()
+                == parse_error::inexact);
+static_assert(fails_with<double>("0.10000000000000000555111512312578270211815834045410156", parse_error::inexact));
+static_assert(parse_exact<double>("0.1000000000000000055511151231257827021181583404541015625")
+                == 0.1);
+static_assert(parse_exact<double>("0x1.00000000000000000000000000001p0").error()
+                == parse_error::inexact);
+
+// the value decides, not the spelling
+static_assert(parse_exact<int>("3.0") == 3);
+static_assert(parse_exact<int>("1e3") == 1000);
+static_assert(parse_exact<std::uint8_t>("0x1p7") == 128);
+static_assert(fails_with<int>("2.5", parse_error::inexact));
+static_assert(fails_with<int>("1e30", parse_error::out_of_range));
+
+// out of range takes precedence over inexact
+static_assert(fails_with<std::int8_t>("127.5", parse_error::inexact));
+static_assert(fails_with<std::int8_t>("128.5", parse_error::out_of_range));
+static_assert(fails_with<std::int8_t>("-128.5", parse_error::out_of_range));
+static_assert(fails_with<unsigned>("-0.5", parse_error::out_of_range));
+static_assert(fails_with<float>("3.5e38", parse_error::out_of_range));
+static_assert(fails_with<int>("1e30000000", parse_error::out_of_range));
+
+// syntax
+static_assert(fails_with<int>("", parse_error::invalid_syntax));
+static_assert(fails_with<int>("-", parse_error::invalid_syntax));
+static_assert(fails_with<int>("1'", parse_error::invalid_syntax));
+static_assert(fails_with<int>("1''0", parse_error::invalid_syntax));
+static_assert(fails_with<int>("'1", parse_error::invalid_syntax));
+static_assert(fails_with<int>("08", parse_error::invalid_syntax));
+static_assert(fails_with<int>("0x", parse_error::invalid_syntax));
+static_assert(fails_with<int>("0b2", parse_error::invalid_syntax));
+static_assert(fails_with<int>(" 1", parse_error::invalid_syntax));
+static_assert(fails_with<int>("1 ", parse_error::invalid_syntax));
+static_assert(fails_with<double>(".", parse_error::invalid_syntax));
+static_assert(fails_with<double>("1e", parse_error::invalid_syntax));
+static_assert(fails_with<double>("0x1.8", parse_error::invalid_syntax));
+static_assert(fails_with<double>("inf", parse_error::invalid_syntax));
+static_assert(fails_with<double>("1.5f", parse_error::invalid_syntax));
+
+// bulk
+static_assert([] {
+  std::array<float, 4> out = {};
+  const std::string_view text = " 1, 0.5\t-2e2\n0x1p-3\r\n";
+  const auto [ptr, count, error] = parse_exact(text, std::span(out));
+  return ptr == text.data() + text.size() && count == 4 && error == parse_error()
+           && out == std::array{1.f, .5f, -200.f, .125f};
+}());
+
+static_assert([] {
+  std::array<std::int16_t, 4> out = {};
+  const std::string_view text = "1 2 70000 4";
+  const auto [ptr, count, error] = parse_exact(text, std::span(out));
+  return ptr == text.data() + 4 && count == 2 && error == parse_error::out_of_range;
+}());
+
+static_assert([] {
+  std::array<int, 2> out = {};
+  const std::string_view text = "1,2,3";
+  const auto r0 = parse_exact(text, std::span(out));
+  if (r0.count != 2 || r0.error != parse_error() || *r0.ptr != '3')
+    return false;
+  const auto r1 = parse_exact(text.substr(4), std::span(out));
+  return r1.count == 1 && out[0] == 3;
+}());
+
+static_assert([] {
+  std::array<int, 2> out = {};
+  const auto r = parse_exact("1;2", std::span(out));
+  return r.count == 0 && r.error == parse_error::invalid_syntax;
+}());
+
+int main()
+{}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val_integer.h>
+
+#include <cstdint>
+
+using vir::operator""_val;
+
+using u8 = std::uint8_t;
+using u16 = std::uint16_t;
+
+// bit_and
+static_assert(std::same_as<decltype(vir::bit_and<0xff_val>(1)), vir::ranged<int, 0, 255>>);
+static_assert(std::same_as<decltype(vir::bit_and<0xff_val>(u8())), vir::ranged<u8, 0, 255>>);
+static_assert(std::same_as<decltype(vir::bit_and<-8_val>(1)), vir::ranged<int>>);
+static_assert(vir::bit_and<0xff_val>(0x1234).value() == 0x34);
+static_assert(vir::bit_and<-8_val>(-1).value() == -8);
+
+// mod
+static_assert(std::same_as<decltype(vir::mod<64_val>(1)), vir::ranged<int, -63, 63>>);
+static_assert(std::same_as<decltype(vir::mod<64_val>(1u)), vir::ranged<unsigned, 0, 63>>);
+static_assert(vir::mod<64_val>(-70).value() == -6);
+static_assert(vir::mod<64_val>(70u).value() == 6);
+
+// clamp
+static_assert(std::same_as<decltype(vir::clamp<0_val, 1023_val>(1)), vir::ranged<int, 0, 1023>>);
+static_assert(vir::clamp<0_val, 1023_val>(5000).value() == 1023);
+static_assert(vir::clamp<0_val, 1023_val>(-5).value() == 0);
+static_assert(vir::clamp<0_val, 1023_val>(17).value() == 17);
+
+// propagation
+static_assert(std::same_as<decltype(vir::mod<64_val>(vir::bit_and<0xfff_val>(1))),
+                           vir::ranged<int, 0, 63>>);
+static_assert(std::same_as<decltype(vir::bit_and<0xff_val>(vir::mod<16_val>(1u))),
+                           vir::ranged<unsigned, 0, 15>>);
+static_assert(std::same_as<decltype(vir::clamp<-5_val, 5_val>(vir::clamp<0_val, 3_val>(1))),
+                           vir::ranged<int, 0, 3>>);
+static_assert(std::same_as<decltype(vir::clamp<5_val, 9_val>(vir::clamp<0_val, 3_val>(1))),
+                           vir::ranged<int, 5, 5>>);
+
+// conversions
+static_assert(std::is_convertible_v<vir::ranged<int, 0, 255>, u8>);
+static_assert(std::is_convertible_v<vir::ranged<int, 0, 1023>, u16>);
+static_assert(std::is_convertible_v<vir::ranged<int, -1, 127>, signed char>);
+static_assert(!std::is_convertible_v<vir::ranged<int, 0, 256>, u8>);
+static_assert(!std::is_convertible_v<vir::ranged<int, -1, 255>, u8>);
+static_assert(!std::is_convertible_v<int, vir::ranged<int, 0, 255>>);
+static_assert(std::is_convertible_v<int, vir::ranged<int>>);
+static_assert(std::is_convertible_v<vir::ranged<u8, 0, 255>, vir::ranged<int, -1, 1000>>);
+static_assert(!std::is_convertible_v<vir::ranged<int, 0, 1000>, vir::ranged<int, 0, 999>>);
+
+// bool and character types
+static_assert(std::is_constructible_v<bool, vir::ranged<int, 0, 255>>);
+static_assert(!std::is_convertible_v<vir::ranged<int, 0, 255>, bool>);
+static_assert(std::is_convertible_v<vir::ranged<int, 0, 1>, bool>);
+static_assert(std::is_convertible_v<vir::ranged<int, 0, 127>, char>);
+static_assert(std::is_convertible_v<vir::ranged<int, 0, 127>, char8_t>);
+static_assert(std::is_convertible_v<vir::ranged<int, 0, 0xffff>, char16_t>);
+static_assert(!std::is_convertible_v<vir::ranged<int, -1, 127>, char32_t>);
+static_assert(!std::is_convertible_v<vir::ranged<int, 0, 0x10000>, char16_t>);
+static_assert(std::is_convertible_v<vir::ranged<char, 'a', 'z'>, vir::ranged<int, 0, 127>>);
+static_assert(std::is_convertible_v<vir::ranged<u8, 0, 127>, vir::ranged<char, 0, 127>>);
+static_assert(!std::is_convertible_v<vir::ranged<u8, 0, 128>, vir::ranged<char8_t, 0, 127>>);
+
+static_assert([] {
+  const auto r = vir::bit_and<0xff_val>(0x1200);
+  const auto s = vir::bit_and<1_val>(3);
+  bool a = s;
+  char b = vir::bit_and<0x7f_val>(0x141);
+  vir::ranged<int, 0, 127> c = vir::clamp<97_val, 122_val>('q'); // ranged<char, 'a', 'z'>
+  if (r)
+    return false;
+  return a && !r && b == 'A' && c.value() == 'q';
+}());
+
+static_assert([] {
+  u8 a = vir::mod<64_val>(vir::bit_and<0xfff_val>(12345));
+  u16 b = vir::clamp<0_val, 1023_val>(5000);
+  vir::ranged<long, 0, 100000> c = vir::clamp<1_val, 10_val>(u16(3));
+  return a == 12345 % 64 && b == 1023 && c.value() == 3;
+}());
+
+int main()
+{}
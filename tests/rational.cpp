@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val.h>
+
+using vir::operator""_val;
+
+// exact values
+static_assert([] {
+  float a = 1_val / 4_val;
+  double b = -3_val / 8_val;
+  int c = 6_val / 3_val;
+  unsigned d = 1_val / (1_val / 5_val);
+  long double e = (1_val / 3_val) / (2_val / 3_val);
+  return a == .25f && b == -.375 && c == 2 && d == 5u && e == .5L;
+}());
+
+// lowest terms
+static_assert([] {
+  constexpr vir::constrational r = 6_val / -4_val;
+  return r._M_num == 3 && r._M_den == 2 && r._M_negative;
+}());
+
+// std::ratio interop
+static_assert(std::same_as<vir::to_ratio<1_val / 3_val>, std::ratio<1, 3>>);
+static_assert(std::same_as<vir::to_ratio<-10_val / 4_val>, std::ratio<-5, 2>>);
+static_assert(std::same_as<vir::to_ratio<vir::val(std::milli())>, std::milli>);
+static_assert([] {
+  double x = vir::val(std::ratio<-1, 1024>());
+  return x == -0x1p-10;
+}());
+
+// rounding policies
+static_assert([] {
+  constexpr auto third = vir::val(1_val / 3_val, vir::round_to_nearest);
+  float a = third;
+  double b = third;
+  long double c = third;
+  double d = -third;
+  float e = vir::val(2_val / 3_val, vir::round_toward_zero);
+  float f = vir::val(2_val / 3_val, vir::round_upward);
+  return a == 1.f / 3 && b == 1. / 3 && c == 1.L / 3 && d == -1. / 3 && e == 0x1.555554p-1f
+           && f == 0x1.555556p-1f;
+}());
+
+#if __LDBL_MANT_DIG__ == 53
+// exact midpoints between two long double values round to even
+static_assert([] {
+  constexpr auto a = vir::val(0x20'0000'0000'0001_val / 4_val, vir::round_to_nearest);
+  constexpr auto b = vir::val(0x20'0000'0000'0003_val / 4_val, vir::round_to_nearest);
+  long double c = a;
+  long double d = b;
+  double e = vir::val(0x20'0000'0000'0001_val / 4_val, vir::round_upward);
+  return c == 0x1p51L && d == 0x1.0000000000002p51L && e == 0x1.0000000000001p51;
+}());
+#endif
+
+static_assert([] {
+  using vir::to_nearest_literals::operator""_val;
+  double x = 1_val / 10_val;
+  return x == .1;
+}());
+
+static_assert([] {
+  constexpr auto third = vir::val(1_val / 3_val, vir::round_to_nearest);
+  return 3. * third == 1. && 6.f * third == 2.f;
+}());
+
+// not value-preserving
+static_assert([] {
+  try
+    {
+      [[maybe_unused]] double x = 1_val / 3_val;
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] int x = 7_val / 2_val;
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] int x = vir::val(1_val / 3_val, vir::round_to_nearest);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      1_val / (18446744073709551615_val / 2_val) / 3_val;
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      1_val / 0_val;
+      return false;
+    }
+  catch (const std::domain_error&) {}
+  return true;
+}());
+
+int main()
+{}
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val.h>
+
+using vir::operator""_val;
+
+constexpr auto pi = vir::val(3.14159265358979323846264338327950288_val, vir::round_to_nearest);
+
+static_assert(static_cast<float>(pi) == 3.14159265358979323846f);
+static_assert(static_cast<double>(pi) == 3.14159265358979323846);
+static_assert(.5f * pi == .5f * 3.14159265358979323846f);
+
+static_assert([] {
+  float a = vir::val(.1_val, vir::round_to_nearest);
+  float b = vir::val(.1_val, vir::round_upward);
+  float c = vir::val(.1_val, vir::round_downward);
+  float d = vir::val(.1_val, vir::round_toward_zero);
+  float e = -vir::val(.1_val, vir::round_downward);
+  float f = vir::val(-.1_val, vir::round_toward_zero);
+  return a == .1f && b > .1L && c < .1L && d == c && e == -b && f == -c;
+}());
+
+static_assert([] {
+  float a = vir::val(0x100'0001_val, vir::round_to_nearest); // tie to even
+  float b = vir::val(0x100'0003_val, vir::round_to_nearest); // tie to even
+  float c = vir::val(0x100'0003_val, vir::round_downward);
+  float d = vir::val(0xffff'ffff'ffff'ffff_val, vir::round_to_nearest);
+  float e = vir::val(-0xffff'ffff'ffff'ffff_val, vir::round_upward);
+  int f = vir::val(3._val, vir::round_to_nearest);
+  return a == 0x1p24f && b == 0x1.000004p24f && c == 0x1.000002p24f && d == 0x1p64f
+           && e == -0x1.fffffep63f && f == 3;
+}());
+
+#if __LDBL_MANT_DIG__ == 64
+// Literals are rounded to long double first. This literal is 1 + 2^-53 + 1.37e-20, i.e. slightly
+// above the midpoint between 1 and the next double. Correct rounding yields 1 + 2^-52, but the
+// long double value of the literal is the midpoint itself, which rounds to even.
+static_assert(static_cast<long double>(1.000000000000000111036_val) == 1 + 0x1p-53L);
+static_assert(static_cast<double>(vir::val(1.000000000000000111036_val, vir::round_to_nearest))
+                == 1.);
+static_assert(static_cast<double>(vir::val(1.000000000000000111036_val, vir::round_upward))
+                == 1 + 0x1p-52);
+#endif
+
+static_assert([] {
+  double a = vir::val(.1_val, vir::within_ulp<1>);
+  float b = vir::val(1e-30_val, vir::within_ulp<1>);
+  float c = vir::val(1.5_val, vir::exact);
+  float d = vir::val(0x1p-140_val, vir::exact);
+  float e = vir::val(0x1p-126_val, vir::no_subnormal);
+  double f = vir::val(0x1p-140_val, vir::no_subnormal);
+  return a == .1 && b == 1e-30f && c == 1.5f && d == 0x1p-140f && e == 0x1p-126f && f == 0x1p-140;
+}());
+
+// the ulp of subnormals is denorm_min
+static_assert([] {
+  float a = vir::val(1e-40_val, vir::within_ulp<1>);
+  float b = vir::val(1e-44_val, vir::within_ulp<1>);
+  double c = vir::val(1e-320_val, vir::within_ulp<1>);
+  return a == 1e-40f && b == 1e-44f && c == 1e-320;
+}());
+
+// near a power of two: 1 - 2^-30 rounds up to 1, the ulp below 1 is 2^-24
+static_assert([] {
+  float a = vir::val(0x1.fffffff8p-1_val, vir::within_ulp<1>);
+  float b = vir::val(0x1.00000002p0_val, vir::within_ulp<1>);
+  float c = vir::val(0x1p-126_val, vir::within_ulp<0>);
+  return a == 1.f && b == 1.f && c == 0x1p-126f;
+}());
+
+static_assert([] {
+  constexpr auto a = vir::enclose<float>(.1_val);
+  constexpr auto b = vir::enclose<double>(-.1_val);
+  constexpr auto c = vir::enclose<float>(.5_val);
+  constexpr auto d = vir::enclose<float>(0x100'0001_val);
+  return a.lower < .1L && a.upper > .1L && a.lower == .1f - 0x1p-27f && !a.is_exact()
+           && b.lower < -.1L && b.upper > -.1L && b.upper - b.lower == 0x1p-56
+           && c.is_exact() && c.lower == .5f
+           && d.lower == 0x1p24f && d.upper == 0x1.000002p24f;
+}());
+
+// the literal is rounded to long double first, thus long double bounds would not be sound
+template <typename T, auto x>
+  concept enclosable = requires { vir::enclose<T>(x); };
+
+static_assert(enclosable<double, .1_val>);
+static_assert(enclosable<long double, 1_val>);
+#if __LDBL_MANT_DIG__ > __DBL_MANT_DIG__
+static_assert(!enclosable<long double, .1_val>);
+#else
+static_assert(!enclosable<double, .1_val>);
+#endif
+
+namespace scoped
+{
+  using vir::to_nearest_literals::operator""_val;
+
+  static_assert(1.f + .1_val == 1.f + .1f);
+  static_assert(static_cast<long double>(.1_val) == .1L);
+}
+
+static_assert([] {
+  try
+    {
+      [[maybe_unused]] float x = vir::val(.1_val, vir::exact);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] float x = vir::val(1e39_val, vir::round_to_nearest); // out of range
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] float x = vir::val(1e-40_val, vir::within_ulp<0>);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] float x = vir::val(0x1.fffffff8p-1_val, vir::within_ulp<0>);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] float x = vir::val(0x1p-140_val, vir::no_subnormal);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] float x
+        = vir::val(1e-40_val, vir::no_subnormal_t<vir::round_t<std::round_to_nearest>>());
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] int x = vir::val(.5_val, vir::round_to_nearest); // integral conversion is exact
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  return true;
+}());
+
+int main()
+{ return 0_val; }
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val_integer.h>
+
+#include <cstdint>
+
+using vir::operator""_val;
+
+using u8 = std::uint8_t;
+using i16 = std::int16_t;
+
+static_assert(vir::add_sat(u8(200), 10_val) == 210);
+static_assert(vir::add_sat(u8(250), 10_val) == 255);
+static_assert(vir::add_sat(10_val, u8(250)) == 255);
+static_assert(vir::add_sat(i16(32760), 10_val) == 32767);
+static_assert(vir::add_sat(i16(-32760), -10_val) == -32768);
+static_assert(vir::add_sat(i16(-32760), 10_val) == -32750);
+static_assert(vir::add_sat(0x7fff'fff0, 0x7fff'ffff_val) == 0x7fff'ffff);
+static_assert(vir::add_sat(-1ll, -0x8000'0000'0000'0000_val) == -0x8000'0000'0000'0000_val);
+
+static_assert(vir::sub_sat(u8(5), 10_val) == 0);
+static_assert(vir::sub_sat(u8(15), 10_val) == 5);
+static_assert(vir::sub_sat(i16(-32760), 10_val) == -32768);
+static_assert(vir::sub_sat(i16(32760), -10_val) == 32767);
+static_assert(vir::sub_sat(-1, -0x8000'0000_val) == 0x7fff'ffff);
+static_assert(vir::sub_sat(0, -0x8000'0000_val) == 0x7fff'ffff);
+static_assert(vir::sub_sat(10_val, u8(20)) == 0);
+static_assert(vir::sub_sat(10_val, u8(3)) == 7);
+static_assert(vir::sub_sat(0_val, i16(-32768)) == 32767);
+static_assert(vir::sub_sat(-2_val, i16(32767)) == -32768);
+static_assert(vir::sub_sat(-2_val, i16(-32768)) == 32766);
+
+static_assert(vir::mul_sat(u8(100), 2_val) == 200);
+static_assert(vir::mul_sat(u8(200), 2_val) == 255);
+static_assert(vir::mul_sat(3_val, u8(86)) == 255);
+static_assert(vir::mul_sat(std::uint16_t(40000), 2_val) == 65535);
+static_assert(vir::mul_sat(i16(20000), 2_val) == 32767);
+static_assert(vir::mul_sat(i16(-20000), 2_val) == -32768);
+static_assert(vir::mul_sat(i16(20000), -2_val) == -32768);
+static_assert(vir::mul_sat(i16(-20000), -2_val) == 32767);
+static_assert(vir::mul_sat(i16(-100), -2_val) == 200);
+static_assert(vir::mul_sat(i16(-32768), -1_val) == 32767);
+static_assert(vir::mul_sat(0x4000'0000, 2_val) == 0x7fff'ffff);
+static_assert(vir::mul_sat(i16(123), 0_val) == 0);
+
+// the constant must be representable in the element type
+static_assert([] {
+  try
+    {
+      vir::add_sat(u8(1), 256_val);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      vir::sub_sat(u8(1), -1_val);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  return true;
+}());
+
+int main()
+{}
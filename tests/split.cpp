@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val_math.h>
+
+#include <bit>
+#include <cstdint>
+
+using vir::operator""_val;
+
+constexpr auto pi_2 = 1.57079632679489661923132169163975144_val;
+
+static_assert([] {
+  constexpr auto d = vir::split<double>(pi_2, 20);
+  constexpr auto e = vir::split<double>(-pi_2, 20);
+  return static_cast<long double>(d[0]) + d[1] == static_cast<long double>(pi_2)
+           && (std::bit_cast<std::uint64_t>(d[0]) & 0xf'ffff) == 0
+           && e[0] == -d[0] && e[1] == -d[1];
+}());
+
+static_assert([] {
+  constexpr auto f = vir::split<float, 3>(pi_2, 12, vir::round_to_nearest);
+  constexpr auto g = vir::split<float>(-.75_val, 12);
+  return (std::bit_cast<std::uint32_t>(f[0]) & 0xfff) == 0
+           && (std::bit_cast<std::uint32_t>(f[1]) & 0xfff) == 0
+           && f[1] != 0 && f[2] != 0
+           && g[0] == -.75f && g[1] == 0;
+}());
+
+#if __LDBL_MANT_DIG__ == 64
+// a literal has the 64 bits of its long double value: two terms of 41 bits hold all of it
+static_assert(vir::split<double, 3>(pi_2, 12)[2] == 0);
+#endif
+
+// results of val_math.h carry a residual: the third term holds the bits beyond long double
+constexpr auto pi_4 = vir::atan(1_val);
+
+static_assert([] {
+  constexpr auto c = vir::split<double, 3>(pi_4, 12, vir::round_to_nearest);
+  constexpr auto f = vir::split<float, 4>(-pi_4, 12, vir::round_to_nearest);
+  constexpr long double nearest = vir::val(pi_4, vir::round_to_nearest);
+  return (std::bit_cast<std::uint64_t>(c[0]) & 0xfff) == 0
+           && (std::bit_cast<std::uint64_t>(c[1]) & 0xfff) == 0
+           && c[2] != 0 && c[2] < 0x1p-80 && c[2] > -0x1p-80
+           && static_cast<long double>(c[0]) + c[1] + c[2] == nearest
+           && (std::bit_cast<std::uint32_t>(f[2]) & 0xfff) == 0
+           && f[3] != 0 && static_cast<long double>(f[0]) + f[1] + f[2] + f[3] == -nearest;
+}());
+
+static_assert([] {
+  try
+    {
+      vir::split<float, 2>(pi_2, 12); // remainder needs more than 24 bits
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  return true;
+}());
+
+int main()
+{}
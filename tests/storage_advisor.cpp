@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/storage_advisor.h>
+
+#include <array>
+#include <cstdint>
+
+using vir::storage_type;
+
+template <typename _From, std::size_t _Np>
+  constexpr std::optional<storage_type>
+  advise(const std::array<_From, _Np>& data)
+  {
+    vir::storage_advisor<_From> adv;
+    adv.update(data);
+    return adv.narrowest();
+  }
+
+static_assert(std::same_as<vir::storage_type_t<storage_type::float32>, float>);
+static_assert(vir::size_of(storage_type::uint16) == 2);
+static_assert(vir::to_string(storage_type::float64) == "float64");
+
+static_assert(advise(std::array{1., -2., 100.}) == storage_type::int8);
+static_assert(advise(std::array{1., 200., 0.}) == storage_type::uint8);
+static_assert(advise(std::array{1., 200., -1.}) == storage_type::int16);
+static_assert(advise(std::array{65535., -0.}) == storage_type::uint16);
+static_assert(advise(std::array{0.5, 0x1p100}) == storage_type::float32);
+static_assert(advise(std::array{0x1p40, -3.}) == storage_type::float32);
+static_assert(advise(std::array{0x1p40 + 1, -3.}) == storage_type::int64);
+static_assert(advise(std::array{0.1, 2.}) == storage_type::float64);
+
+// infinities and NaN are preserved by the floating-point types and only exclude integers
+constexpr double inf = std::numeric_limits<double>::infinity();
+constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+static_assert(advise(std::array{0.1, inf}) == storage_type::float64);
+static_assert(advise(std::array{1., -inf}) == storage_type::float32);
+static_assert(advise(std::array{1., nan, 2.}) == storage_type::float32);
+static_assert(advise(std::array{nan}) == storage_type::float32);
+static_assert([] {
+  vir::storage_advisor<double> adv;
+  adv.update(std::array{1., 2., nan});
+  return !adv.preserves(storage_type::int8) && !adv.preserves(storage_type::uint64)
+           && adv.preserves(storage_type::float32) && adv.preserves(storage_type::float64);
+}());
+#if __LDBL_MAX_EXP__ > __DBL_MAX_EXP__
+static_assert(advise(std::array{1.L, 0x1p2000L}) == std::nullopt);
+#endif
+
+static_assert(advise(std::array<std::int64_t, 2>{-32768, 32767}) == storage_type::int16);
+static_assert(advise(std::array<std::int64_t, 2>{0, 4294967295}) == storage_type::uint32);
+static_assert(advise(std::array<std::int64_t, 2>{-1, 4294967296}) == storage_type::float32);
+static_assert(advise(std::array<std::int64_t, 2>{-1, 4294967297}) == storage_type::int64);
+
+// several updates accumulate
+static_assert([] {
+  vir::storage_advisor<double> adv;
+  adv.update(std::array{1., 2.});
+  if (adv.narrowest() != storage_type::int8)
+    return false;
+  adv.update(std::array{-1000.});
+  return adv.narrowest() == storage_type::int16 && !adv.preserves(storage_type::uint16)
+           && adv.preserves(storage_type::float32);
+}());
+
+// multiple blocks
+static_assert([] {
+  std::array<double, 5000> data = {};
+  data[4999] = 0.5;
+  vir::storage_advisor<double> adv;
+  adv.update(data);
+  return adv.narrowest() == storage_type::float32;
+}());
+
+int main()
+{}
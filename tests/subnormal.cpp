@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#define VIR_VAL_REJECT_SUBNORMALS 1
+#include <vir/val.h>
+
+using vir::operator""_val;
+
+static_assert([] {
+  float a = 0x1p-126_val;
+  double b = 0x1p-140_val;
+  float c = 0._val;
+  float d = -0x1p-126_val;
+  return a == 0x1p-126f && b == 0x1p-140 && c == 0 && d == -0x1p-126f;
+}());
+
+static_assert([] {
+  try
+    {
+      [[maybe_unused]] float x = 0x1p-140_val;
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] float x = -0x1p-140_val;
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  try
+    {
+      [[maybe_unused]] float x = vir::val(1e-40_val, vir::round_to_nearest);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  return true;
+}());
+
+int main()
+{ return 0_val; }
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/val.h>
+
+#include <cstdint>
+
+using vir::operator""_val;
+
+constexpr auto t0 = vir::table<short>(1_val, -10_val, 0x7fff_val, 1000._val, vir::val(2u));
+static_assert(t0.size() == 5);
+static_assert(t0[1] == -10 && t0[2] == 0x7fff && t0[3] == 1000);
+
+constexpr auto t1 = vir::tabulate<unsigned short, 256>([](std::size_t i) consteval {
+                      return vir::val(i * i);
+                    });
+static_assert(t1[255] == 65025);
+
+constexpr auto& t2 = vir::tabulated<float, 0x10000, [](std::size_t i) consteval {
+                       return vir::val(static_cast<double>(i) / 4);
+                     }>;
+static_assert(t2[0xffff] == 16383.75f);
+
+static_assert([] {
+  try
+    {
+      vir::tabulate<signed char, 200>([](std::size_t i) consteval { return i; });
+      return false;
+    }
+  catch (const vir::bad_table_element_cast& e)
+    {
+      return e.index() == 128;
+    }
+}());
+
+static_assert([] {
+  try
+    {
+      vir::table<float>(1_val, 0x100'0001_val);
+      return false;
+    }
+  catch (const vir::bad_value_preserving_cast&) {}
+  return true;
+}());
+
+// the reported location is the table() call, for every element
+static_assert([] {
+  try
+    {
+      vir::table<short>(0x8000_val, 1_val);
+      return false;
+    }
+  catch (const vir::bad_table_element_cast& e)
+    {
+      if (e.index() != 0 || e.where().line() != __LINE__ - 5)
+        return false;
+    }
+  try
+    {
+      vir::table<short>(1_val, 2_val, 0x8000_val);
+      return false;
+    }
+  catch (const vir::bad_table_element_cast& e)
+    {
+      return e.index() == 2 && e.where().line() == __LINE__ - 5;
+    }
+}());
+
+static_assert(vir::table<short>().empty());
+
+int main()
+{
+  if (reinterpret_cast<std::uintptr_t>(&t2) % 64 != 0)
+    return 1;
+  return t1[0] + static_cast<int>(t2[0]);
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+#include <vir/value_preserving_cast.h>
+
+#include <bit>
+#include <cstdint>
+
+using vir::value_preserving_cast;
+using vir::cast_error;
+
+template <typename _To, typename _From>
+  constexpr bool
+  fails_with(_From x, cast_error e)
+  { return value_preserving_cast<_To>(x).error() == e; }
+
+// integral → integral
+constexpr std::int32_t i32min = std::numeric_limits<std::int32_t>::min();
+static_assert(value_preserving_cast<std::int32_t>(std::int64_t(i32min)) == i32min);
+static_assert(fails_with<std::int32_t>(std::int64_t(0x8000'0000), cast_error::out_of_range));
+static_assert(fails_with<std::int32_t>(std::int64_t(i32min) - 1, cast_error::out_of_range));
+static_assert(value_preserving_cast<unsigned char>(255) == 255);
+static_assert(fails_with<unsigned char>(-1, cast_error::out_of_range));
+static_assert(fails_with<int>(~0u, cast_error::out_of_range));
+static_assert(value_preserving_cast<std::uint64_t>(std::int64_t(1) << 62) == 1ull << 62);
+
+// integral → floating-point
+static_assert(value_preserving_cast<double>(std::int64_t(1) << 53) == 0x1p53);
+static_assert(fails_with<double>((std::int64_t(1) << 53) + 1, cast_error::inexact));
+static_assert(fails_with<double>(std::numeric_limits<std::int64_t>::max(), cast_error::inexact));
+static_assert(value_preserving_cast<double>(std::numeric_limits<std::int64_t>::min()) == -0x1p63);
+static_assert(fails_with<float>(~0ull, cast_error::inexact));
+static_assert(value_preserving_cast<double>(-7) == -7.);
+
+// floating-point → integral
+static_assert(value_preserving_cast<std::int16_t>(-32768.f) == -32768);
+static_assert(fails_with<std::int16_t>(32768.f, cast_error::out_of_range));
+static_assert(fails_with<std::int16_t>(1.5f, cast_error::inexact));
+static_assert(fails_with<unsigned>(-1., cast_error::out_of_range));
+static_assert(value_preserving_cast<unsigned>(-0.) == 0u);
+static_assert(fails_with<std::int64_t>(0x1p63, cast_error::out_of_range));
+static_assert(value_preserving_cast<std::int64_t>(-0x1p63) == std::numeric_limits<std::int64_t>::min());
+static_assert(fails_with<int>(std::numeric_limits<double>::quiet_NaN(), cast_error::out_of_range));
+
+// floating-point → floating-point
+static_assert(value_preserving_cast<float>(0.5) == .5f);
+static_assert(fails_with<float>(0.1, cast_error::inexact));
+static_assert(fails_with<float>(0x1p128, cast_error::out_of_range));
+static_assert(value_preserving_cast<float>(-0x1.fffffep127) == -0x1.fffffep127f);
+static_assert(fails_with<double>(std::numeric_limits<float>::infinity(), cast_error::out_of_range));
+static_assert(fails_with<float>(std::numeric_limits<double>::quiet_NaN(), cast_error::out_of_range));
+static_assert(value_preserving_cast<double>(0.1f) == double(0.1f));
+static_assert(std::bit_cast<std::uint32_t>(*value_preserving_cast<float>(-0.)) == 0x8000'0000u);
+static_assert(fails_with<float>(-0x1p128, cast_error::out_of_range));
+static_assert(fails_with<float>(-std::numeric_limits<double>::quiet_NaN(), cast_error::out_of_range));
+static_assert(fails_with<float>(0x1p-150, cast_error::inexact));
+#ifndef VIR_VAL_REJECT_SUBNORMALS
+static_assert(value_preserving_cast<float>(0x1p-149) == 0x1p-149f);
+#else
+static_assert(fails_with<float>(0x1p-149, cast_error::subnormal));
+#endif
+
+// trap policy
+static_assert(value_preserving_cast<float>(0.25, vir::trap) == .25f);
+static_assert(value_preserving_cast<std::int8_t>(-128, vir::trap) == -128);
+
+// val_cast
+template <typename T>
+  constexpr T
+  scale(T x, int k)
+  { return x * vir::val_cast<T>(k); }
+
+static_assert(scale(0.5f, 1 << 24) == 0x1p23f);
+static_assert(vir::val_cast<std::int16_t>(-32768.) == -32768);
+static_assert(vir::val_cast<float>(0.25, vir::assume) == .25f);
+
+template <typename T, auto x>
+  concept constant_val_cast = requires { typename std::integral_constant<T, vir::val_cast<T>(x)>; };
+
+static_assert(constant_val_cast<float, 16777216>);
+static_assert(!constant_val_cast<float, 16777217>);
+static_assert(!constant_val_cast<unsigned, -1>);
+
+int main()
+{
+  // folded after inlining: no runtime check, no compile error
+  constexpr int k = 1 << 20;
+  if (scale(2.f, k) != 0x1p21f)
+    return 1;
+  volatile double x = 0.5;
+  if (vir::val_cast<float>(x) != .5f || vir::val_cast<float>(x, vir::assume) != .5f)
+    return 1;
+}
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+//                       Matthias Kretz <m.kretz@gsi.de>
+
+// vir-storage-advisor: report the narrowest type that preserves every value of a raw binary
+// column file (native endianness) and optionally write the downcast column.
+//
+// usage: vir-storage-advisor [--int64] [-o OUTPUT] INPUT
+//
+// The input is memory-mapped and processed in windows; pages of finished windows are released
+// so that the resident set size stays bounded independent of the file size.
+
+#include <vir/narrow_exact.h>
+#include <vir/storage_advisor.h>
+
+#include <cerrno>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  /// Bytes of input processed per window.
+  constexpr std::size_t window_bytes = std::size_t(64) << 20;
+
+  int
+  fail(const char* what, const char* name)
+  {
+    std::fprintf(stderr, "vir-storage-advisor: %s '%s': %s\n", what, name, std::strerror(errno));
+    return 1;
+  }
+
+  class mapped_file
+  {
+    const std::byte* _M_data = nullptr;
+    std::size_t _M_size = 0;
+
+  public:
+    explicit
+    mapped_file(int fd, std::size_t size)
+    : _M_size(size)
+    {
+      if (size == 0)
+        return;
+      void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED)
+        {
+          _M_data = static_cast<const std::byte*>(p);
+          ::madvise(p, size, MADV_SEQUENTIAL);
+        }
+    }
+
+    mapped_file(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+      if (_M_data)
+        ::munmap(const_cast<std::byte*>(_M_data), _M_size);
+    }
+
+    bool
+    valid() const
+    { return _M_data != nullptr || _M_size == 0; }
+
+    /// Call @p fun for every window of the file interpreted as array of T; release the pages of
+    /// each window afterwards.
+    template <typename T, typename F>
+      bool
+      for_each_window(F&& fun) const
+      {
+        const std::size_t n = _M_size / sizeof(T);
+        constexpr std::size_t window = window_bytes / sizeof(T);
+        for (std::size_t i = 0; i < n; i += window)
+          {
+            const auto* first = reinterpret_cast<const T*>(_M_data) + i;
+            const std::size_t len = std::min(window, n - i);
+            if (!fun(std::span<const T>(first, len)))
+              return false;
+            ::madvise(const_cast<T*>(first), len * sizeof(T), MADV_DONTNEED);
+          }
+        return true;
+      }
+  };
+
+  /// Like vir::narrow_exact, but infinities and NaN are converted to floating-point types (as
+  /// vir::storage_advisor considers them preserved).
+  template <typename From, typename To>
+    bool
+    convert(std::span<const From> in, std::span<To> out)
+    {
+      for (std::size_t i = 0; i < in.size(); ++i)
+        {
+          i += vir::narrow_exact(in.subspan(i), out.subspan(i));
+          if (i == in.size())
+            break;
+          if constexpr (std::floating_point<From> && std::floating_point<To>)
+            {
+              if (std::isfinite(in[i]))
+                return false;
+              out[i] = static_cast<To>(in[i]);
+            }
+          else
+            return false;
+        }
+      return true;
+    }
+
+  template <typename From>
+    int
+    run(const mapped_file& in, const char* output)
+    {
+      vir::storage_advisor<From> adv;
+      in.for_each_window<From>([&](std::span<const From> w) { adv.update(w); return true; });
+      const std::optional<vir::storage_type> t = adv.narrowest();
+      if (!t)
+        {
+          std::puts("none");
+          return output ? 1 : 0;
+        }
+      std::printf("%.*s (%zu of %zu bytes per value)\n", int(vir::to_string(*t).size()),
+                  vir::to_string(*t).data(), vir::size_of(*t), sizeof(From));
+      if (!output)
+        return 0;
+
+      std::FILE* out = std::fopen(output, "wb");
+      if (!out)
+        return fail("cannot open", output);
+      // remove a partial output on failure, but never e.g. a device
+      struct stat st;
+      const bool regular = ::fstat(::fileno(out), &st) == 0 && S_ISREG(st.st_mode);
+      bool lossy = false;
+      const bool ok = vir::visit(*t, [&]<typename To>(std::type_identity<To>) {
+        std::vector<To> buffer(window_bytes / sizeof(From));
+        return in.for_each_window<From>([&](std::span<const From> w) {
+          const std::span<To> converted(buffer.data(), w.size());
+          lossy = !convert(w, converted);
+          return !lossy
+                   && std::fwrite(converted.data(), sizeof(To), w.size(), out) == w.size();
+        });
+      });
+      const int write_errno = errno;
+      const bool closed = std::fclose(out) == 0;
+      if (lossy)
+        {
+          // only if the input changed after storage_advisor saw it
+          std::fprintf(stderr, "vir-storage-advisor: input not preserved by %.*s in '%s'\n",
+                       int(vir::to_string(*t).size()), vir::to_string(*t).data(), output);
+          if (regular)
+            std::remove(output);
+          return 1;
+        }
+      if (!ok || !closed)
+        {
+          if (!ok)
+            errno = write_errno;
+          fail("cannot write", output);
+          if (regular)
+            std::remove(output);
+          return 1;
+        }
+      return 0;
+    }
+}
+
+int
+main(int argc, char** argv)
+{
+  bool int64 = false;
+  const char* output = nullptr;
+  const char* input = nullptr;
+  bool usage_error = false;
+  for (int i = 1; i < argc; ++i)
+    {
+      const std::string_view arg = argv[i];
+      if (arg == "--int64")
+        int64 = true;
+      else if (arg == "-o" && i + 1 < argc)
+        output = argv[++i];
+      else if (!input && !arg.starts_with('-'))
+        input = argv[i];
+      else
+        usage_error = true;
+    }
+  if (!input || usage_error)
+    {
+      std::fputs("usage: vir-storage-advisor [--int64] [-o OUTPUT] INPUT\n"
+                 "  INPUT is a raw array of double (default) or int64 values\n", stderr);
+      return 2;
+    }
+
+  const int fd = ::open(input, O_RDONLY);
+  if (fd < 0)
+    return fail("cannot open", input);
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+    {
+      fail("cannot stat", input);
+      ::close(fd);
+      return 1;
+    }
+  const mapped_file in(fd, std::size_t(st.st_size));
+  if (!in.valid())
+    {
+      fail("cannot map", input);
+      ::close(fd);
+      return 1;
+    }
+  ::close(fd);
+  if (std::size_t(st.st_size) % 8 != 0)
+    {
+      std::fprintf(stderr, "vir-storage-advisor: size of '%s' is not a multiple of 8\n", input);
+      return 1;
+    }
+
+  return int64 ? run<std::int64_t>(in, output) : run<double>(in, output);
+}